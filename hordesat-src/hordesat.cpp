@@ -9,16 +9,33 @@
 #include "solvers/CandyHorde.h"
 #include "solvers/MiniSat.h"
 #include "solvers/Lingeling.h"
+#include "solvers/Cadical.h"
+#include "solvers/Kissat.h"
+#include "solvers/ProbSat.h"
 #include "utilities/DebugUtils.h"
 #include "utilities/Threading.h"
 #include "utilities/ParameterProcessor.h"
+#include "utilities/PortfolioSpec.h"
+#include "utilities/CubeQueue.h"
+#include "utilities/Preprocessor.h"
+#include "utilities/Diversification.h"
+#include "utilities/AdaptivePortfolio.h"
+#include "utilities/MemoryGovernor.h"
+#include "utilities/Telemetry.h"
+#include "utilities/Tracer.h"
+#include "utilities/ProgressReporter.h"
+#include "utilities/Topology.h"
+#include "utilities/SatUtils.h"
 #include "sharing/AllToAllSharingManager.h"
 #include "sharing/LogSharingManager.h"
+#include "sharing/WorkStealingManager.h"
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <mpi.h>
 #include <algorithm>
+#include <atomic>
 #include <csignal>
 #include <unistd.h>
 #include "utilities/Logger.h"
@@ -30,14 +47,53 @@ int solversCount = 0;
 bool solvingDoneLocal = false;
 SatResult finalResult = UNKNOWN;
 Mutex interruptLock;
+// the solver that found the model
+PortfolioSolverInterface* winningSolver = NULL;
 
 SharingManagerInterface* sharingManager = NULL;
+PortfolioSpec portfolio;
+bool usePortfolio = false;
+
+// the best local search assignment, given to the other solvers as phases
+Mutex phaseLock;
+vector<int> sharedPhases;
+// read by the solver threads without the lock
+atomic<int> sharedPhasesVersion(0);
+int sharedPhasesUnsat = -1;
+double lastPhaseExport = 0;
+
+// cube and conquer
+bool cubeMode = false;
+CubeQueue cubeQueue;
+int totalCubes = 0;
+WorkStealingManager* workStealingManager = NULL;
+
+// the options given to each solver and the controller changing them
+vector<vector<pair<string, int> > > solverOptions;
+AdaptivePortfolio* adaptivePortfolio = NULL;
+
+// keeps the memory of the process under the budget given by -mem
+MemoryGovernor* memoryGovernor = NULL;
+
+// preprocessing, done once per node
+bool usePreprocessing = false;
+Preprocessor preprocessor;
+
+// the CPU of each solver thread, empty if the threads are not pinned
+vector<int> solverCpus;
+// the main thread (the MPI communication) runs on the NUMA node of solver 0
+vector<int> mainThreadCpus;
 
 // =========================
 // end detection
 // =========================
 #define SOLVING_DONE -10
 int* endingBuffer = NULL;
+// seconds the last ending detection took
+double endingTime = 0;
+// gathers the progress values after the ending detection if set
+ProgressReporter* progressReporter = NULL;
+int endingRound = 0;
 
 void initializeEndingDetection(int mpi_size) {
 	endingBuffer = new int[mpi_size];
@@ -47,18 +103,33 @@ void stopAllSolvers() {
 	interruptLock.lock();
 	solvingDoneLocal = true;
 	for (int i = 0; i < solversCount; i++) {
-		solvers[i]->setSolverInterrupt();
+		// a stopped solver may already be released by the memory governor
+		if (memoryGovernor == NULL || !memoryGovernor->isStopped(i)) {
+			solvers[i]->setSolverInterrupt();
+		}
 	}
 	interruptLock.unlock();
 }
 
+// Kissat solves only once, an interrupt ends its search for good, so only
+// stopAllSolvers may interrupt it
+bool canResume(PortfolioSolverInterface* solver) {
+	return dynamic_cast<Kissat*>(solver) == NULL;
+}
+
 // Return true if the solver should stop.
 bool getGlobalEnding(int mpi_size, int mpi_rank) {
+	TraceSpan span("ending");
 	int sendMsg = 0;
 	if (solvingDoneLocal) {
 		sendMsg = SOLVING_DONE;
 	}
+	double start = getTime();
 	MPI_Allgather(&sendMsg, 1, MPI_INT, endingBuffer, 1, MPI_INT, MPI_COMM_WORLD);
+	endingTime = getTime() - start;
+	if (progressReporter != NULL) {
+		progressReporter->report(endingRound++);
+	}
 	for (int r = 0; r < mpi_size; r++) {
 		if (endingBuffer[r] == SOLVING_DONE) {
 			stopAllSolvers();
@@ -68,8 +139,171 @@ bool getGlobalEnding(int mpi_size, int mpi_rank) {
 	return false;
 }
 
+// =========================
+// local search phases
+// =========================
+void importSharedPhases(PortfolioSolverInterface* solver, int& version) {
+	vector<int> phases;
+	phaseLock.lock();
+	phases = sharedPhases;
+	version = sharedPhasesVersion;
+	phaseLock.unlock();
+	for (size_t i = 0; i < phases.size(); i++) {
+		solver->setPhase(abs(phases[i]), phases[i] > 0);
+	}
+}
+
+// Publish the best improved local search assignment as the phases of the
+// CDCL solvers. The ones with an import callback take it at their next import
+// point, the others before their next solve call, none of them is interrupted.
+void exportLocalSearchPhases(double interval) {
+	TraceSpan span("phases");
+	if (getTime() - lastPhaseExport < interval) {
+		return;
+	}
+	vector<int> phases;
+	vector<int> bestPhases;
+	int bestUnsat = -1;
+	int unsat;
+	for (int sid = 0; sid < solversCount; sid++) {
+		if (solvers[sid] == NULL) {
+			continue;
+		}
+		ProbSat* sls = dynamic_cast<ProbSat*>(solvers[sid]);
+		if (sls != NULL && sls->getBestAssignment(phases, unsat) && (bestUnsat < 0 || unsat < bestUnsat)) {
+			bestPhases.swap(phases);
+			bestUnsat = unsat;
+		}
+	}
+	if (bestUnsat < 0 || (sharedPhasesUnsat >= 0 && bestUnsat >= sharedPhasesUnsat)) {
+		return;
+	}
+	for (int sid = 0; sid < solversCount; sid++) {
+		if (solvers[sid] != NULL && dynamic_cast<ProbSat*>(solvers[sid]) == NULL) {
+			solvers[sid]->setPendingPhases(bestPhases);
+		}
+	}
+	phaseLock.lock();
+	sharedPhases.swap(bestPhases);
+	sharedPhasesUnsat = bestUnsat;
+	sharedPhasesVersion++;
+	phaseLock.unlock();
+	lastPhaseExport = getTime();
+	log(2, "exporting local search phases with %d unsatisfied clauses\n", bestUnsat);
+}
+
+// =========================
+// cube and conquer
+// =========================
+bool supportsAssumptions(PortfolioSolverInterface* solver) {
+	return dynamic_cast<ProbSat*>(solver) == NULL && dynamic_cast<Kissat*>(solver) == NULL;
+}
+
+// Send the vector of rank 0 to all the ranks
+void broadcastVector(vector<int>& data) {
+	int len = data.size();
+	MPI_Bcast(&len, 1, MPI_INT, 0, MPI_COMM_WORLD);
+	data.resize(len);
+	MPI_Bcast(data.data(), len, MPI_INT, 0, MPI_COMM_WORLD);
+}
+
+// Rank 0 splits the formula into cubes and sends them to everybody, each node
+// takes every mpi_size-th cube. The variables of all the cubes and the
+// variables for splitting cubes later are frozen (also for the preprocessing),
+// so they stay usable as assumptions.
+void initializeCubes(int depth, int mpi_rank, int mpi_size, vector<vector<int> >& formula) {
+	vector<int> flat;
+	vector<int> splitVars;
+	if (mpi_rank == 0) {
+		vector<vector<int> > cubes = generateCubes(formula, depth);
+		for (size_t i = 0; i < cubes.size(); i++) {
+			flat.insert(flat.end(), cubes[i].begin(), cubes[i].end());
+			flat.push_back(0);
+		}
+		splitVars = getFrequentVariables(formula, CUBE_SPLIT_VARIABLES);
+	}
+	broadcastVector(flat);
+	broadcastVector(splitVars);
+	vector<bool> cubeWorkers;
+	for (int sid = 0; sid < solversCount; sid++) {
+		cubeWorkers.push_back(supportsAssumptions(solvers[sid]));
+	}
+	cubeQueue.setWorkers(cubeWorkers);
+	cubeQueue.setSplitVariables(splitVars);
+
+	vector<bool> frozen;
+	vector<int> toFreeze(splitVars);
+	toFreeze.insert(toFreeze.end(), flat.begin(), flat.end());
+	for (size_t i = 0; i < toFreeze.size(); i++) {
+		int var = abs(toFreeze[i]);
+		if ((int)frozen.size() <= var) {
+			frozen.resize(var+1, false);
+		}
+		if (var != 0 && !frozen[var]) {
+			frozen[var] = true;
+			preprocessor.freeze(var);
+			for (int sid = 0; sid < solversCount; sid++) {
+				solvers[sid]->freezeVariable(var);
+			}
+		}
+	}
+
+	vector<int> cube;
+	int myCubes = 0;
+	for (size_t i = 0; i < flat.size(); i++) {
+		if (flat[i] != 0) {
+			cube.push_back(flat[i]);
+			continue;
+		}
+		if (totalCubes % mpi_size == mpi_rank) {
+			cubeQueue.add(cube);
+			myCubes++;
+		}
+		totalCubes++;
+		cube.clear();
+	}
+	log(1, "Node %d got %d of the %d cubes\n", mpi_rank, myCubes, totalCubes);
+}
+
+// Give the negations of the refuted cubes to the local solvers and finish
+// with UNSAT when the refuted cubes of all the nodes cover the search space.
+void checkCubes() {
+	TraceSpan span("cubes");
+	vector<vector<int> > clauses;
+	cubeQueue.fetchRefutedClauses(clauses);
+	if (!clauses.empty()) {
+		for (int sid = 0; sid < solversCount; sid++) {
+			// a stopped solver would only queue them up
+			if (memoryGovernor == NULL || !memoryGovernor->isStopped(sid)) {
+				solvers[sid]->addLearnedClauses(clauses);
+			}
+		}
+	}
+	unsigned long long localRefuted = cubeQueue.getRefutedWeight();
+	unsigned long long globalRefuted = 0;
+	MPI_Allreduce(&localRefuted, &globalRefuted, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+	if (globalRefuted == 1ULL << CUBE_WEIGHT_BITS) {
+		log(1, "all cubes refuted\n");
+		finalResult = UNSAT;
+		solvingDoneLocal = true;
+	}
+}
+
 void* solverRunningThread(void* arg) {
 	PortfolioSolverInterface* solver = (PortfolioSolverInterface*)arg;
+	bool localSearch = dynamic_cast<ProbSat*>(solver) != NULL;
+	int phasesVersion = 0;
+	// without a cube (none left) the thread works on the whole formula
+	bool cubeWorker = cubeMode && supportsAssumptions(solver);
+	bool hasCube = false;
+	int worker = find(solvers.begin(), solvers.end(), solver) - solvers.begin();
+	if (!solverCpus.empty()) {
+		pinCurrentThread(solverCpus[worker]);
+	}
+	char threadName[32];
+	snprintf(threadName, sizeof(threadName), "solver %d", worker);
+	setTraceThreadName(threadName);
+	vector<int> cube;
 	while (true) {
 		interruptLock.lock();
 		if (solvingDoneLocal) {
@@ -79,8 +313,41 @@ void* solverRunningThread(void* arg) {
 			solver->unsetSolverInterrupt();
 		}
 		interruptLock.unlock();
-		SatResult res = solver->solve();
+		if (memoryGovernor != NULL && memoryGovernor->isStopped(worker)) {
+			log(1, "solver %d stopped to save memory\n", worker);
+			memoryGovernor->threadExited(worker);
+			break;
+		}
+		if (!localSearch && phasesVersion != sharedPhasesVersion) {
+			importSharedPhases(solver, phasesVersion);
+		}
+		if (cubeWorker && !hasCube) {
+			hasCube = cubeQueue.take(cube, worker);
+		} else if (hasCube && cubeQueue.splitIfRequested(cube, worker)) {
+			log(2, "split a cube, continuing with %lu literals\n", cube.size());
+		}
+		if (adaptivePortfolio != NULL) {
+			adaptivePortfolio->applyPending(worker);
+		}
+		if (memoryGovernor != NULL) {
+			memoryGovernor->applyPending(worker);
+		}
+		double solveStart = getTime();
+		SatResult res = hasCube ? solver->solve(cube) : solver->solve();
+		if (tracingEnabled) {
+			addTraceEvent("solve", solveStart, getTime());
+		}
+		if (res == UNSAT && hasCube && !cube.empty()) {
+			cubeQueue.refuted(cube, worker);
+			hasCube = false;
+			continue;
+		}
 		if (res == SAT) {
+			interruptLock.lock();
+			if (winningSolver == NULL) {
+				winningSolver = solver;
+			}
+			interruptLock.unlock();
 			solvingDoneLocal = true;
 			finalResult = SAT;
 		}
@@ -88,6 +355,11 @@ void* solverRunningThread(void* arg) {
 			solvingDoneLocal = true;
 			finalResult = UNSAT;
 		}
+		if (res == UNKNOWN && !canResume(solver)) {
+			// calling solve again would return at once, the thread would spin
+			log(1, "solver %d was interrupted and cannot resume, its thread ends\n", worker);
+			break;
+		}
 	}
 	return NULL;
 }
@@ -143,8 +415,9 @@ void binValueDiversification(int mpi_size, int mpi_rank) {
 	}
     int vars = solvers[0]->getVariablesCount();
     for (int sid = 0; sid < solversCount; sid++) {
-    	int num = mpi_rank * sid;
-		for (int var = 1; var < vars; var++) {
+    	// the global number of the solver, its bits are the phases
+    	int num = mpi_rank * solversCount + sid;
+		for (int var = 1; var <= vars; var++) {
 			int bit = var % log;
 			bool phase = (num >> bit) & 1 ? true : false;
 			solvers[sid]->setPhase(var, phase);
@@ -152,6 +425,218 @@ void binValueDiversification(int mpi_size, int mpi_rank) {
     }
 }
 
+// =========================
+// model output
+// =========================
+// The lowest rank with a model sends it to rank 0, the model is
+// extended to the variables removed by the preprocessing first.
+bool gatherModel(int mpi_rank, vector<int>& model) {
+	int localRank = finalResult == SAT ? mpi_rank : INT_MAX;
+	int satRank;
+	MPI_Allreduce(&localRank, &satRank, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+	if (satRank == INT_MAX) {
+		return false;
+	}
+	if (mpi_rank == satRank) {
+		model = winningSolver->getSolution();
+		if (usePreprocessing) {
+			preprocessor.extendModel(model);
+		}
+		if (satRank != 0) {
+			MPI_Send(model.data(), model.size(), MPI_INT, 0, 0, MPI_COMM_WORLD);
+		}
+	}
+	if (mpi_rank == 0 && satRank != 0) {
+		MPI_Status status;
+		int len;
+		MPI_Probe(satRank, 0, MPI_COMM_WORLD, &status);
+		MPI_Get_count(&status, MPI_INT, &len);
+		model.resize(len);
+		MPI_Recv(model.data(), len, MPI_INT, satRank, 0, MPI_COMM_WORLD, &status);
+	}
+	return true;
+}
+
+void printModel(const vector<int>& model) {
+	printf("v");
+	for (size_t i = 1; i < model.size(); i++) {
+		printf(" %d", model[i]);
+		if (i % 10 == 0) {
+			printf("\nv");
+		}
+	}
+	printf(" 0\n");
+}
+
+string getSolverName(PortfolioSolverInterface* solver) {
+	if (dynamic_cast<Lingeling*>(solver) != NULL) return "lingeling";
+	if (dynamic_cast<MiniSat*>(solver) != NULL) return "minisat";
+	if (dynamic_cast<CandyHorde*>(solver) != NULL) return "candy";
+	if (dynamic_cast<Cadical*>(solver) != NULL) return "cadical";
+	if (dynamic_cast<Kissat*>(solver) != NULL) return "kissat";
+	if (dynamic_cast<ProbSat*>(solver) != NULL) return "probsat";
+	return "unknown";
+}
+
+// Give each solver options sampled for its global slot number and report
+// how many distinct configurations the whole portfolio has.
+void sampledDiversification(int mpi_rank, int mpi_size) {
+	vector<unsigned long long> hashes(solversCount);
+	for (int sid = 0; sid < solversCount; sid++) {
+		int slot = mpi_rank * solversCount + sid;
+		string name = getSolverName(solvers[sid]);
+		vector<pair<string, int> > options = sampleOptions(name, slot);
+		vector<pair<string, int> > applied;
+		string description;
+		for (size_t i = 0; i < options.size(); i++) {
+			if (solvers[sid]->setOption(options[i].first.c_str(), options[i].second)) {
+				applied.push_back(options[i]);
+				char buffer[128];
+				snprintf(buffer, sizeof(buffer), " %s=%d", options[i].first.c_str(), options[i].second);
+				description += buffer;
+			}
+		}
+		solverOptions[sid] = applied;
+		hashes[sid] = configurationHash(name, applied);
+		log(2, "slot %d %s options:%s\n", slot, name.c_str(), description.c_str());
+	}
+	vector<unsigned long long> allHashes(mpi_rank == 0 ? mpi_size * solversCount : 0);
+	MPI_Gather(hashes.data(), solversCount, MPI_UNSIGNED_LONG_LONG, allHashes.data(), solversCount,
+			MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
+	if (mpi_rank == 0) {
+		sort(allHashes.begin(), allHashes.end());
+		int distinct = unique(allHashes.begin(), allHashes.end()) - allHashes.begin();
+		log(1, "diversification: %d distinct option configurations in %d slots (seeds and phases not counted)\n",
+				distinct, mpi_size * solversCount);
+	}
+}
+
+// Rank 0 prints the minimum, maximum (with the rank) and average over the
+// nodes of each statistic, to find the stragglers
+void reduceNodeStatistics(int mpi_rank, int mpi_size, double searchTime, SolvingStatistics& st,
+		SharingStatistics& sh) {
+	const char* names[] = {"confs/s", "props/s", "decs/s", "restarts", "learned", "deleted", "imported",
+			"fixed", "mem-peak", "mem-current", "import-time", "export-time", "shared", "filtered",
+			"exchange-time"};
+	double values[] = {st.conflicts/searchTime, st.propagations/searchTime, st.decisions/searchTime,
+			(double)st.restarts, (double)st.learnedClauses, (double)st.deletedClauses, (double)st.importedClauses,
+			(double)st.fixedUnits, st.memPeak, st.memCurrent, st.importTime, st.exportTime,
+			(double)sh.sharedClauses, (double)sh.filteredClauses, sh.exchangeTime};
+	const int count = sizeof(values)/sizeof(double);
+	struct {
+		double value;
+		int rank;
+	} local[count], minimum[count], maximum[count];
+	double sum[count];
+	for (int i = 0; i < count; i++) {
+		local[i].value = values[i];
+		local[i].rank = mpi_rank;
+	}
+	MPI_Reduce(local, minimum, count, MPI_DOUBLE_INT, MPI_MINLOC, 0, MPI_COMM_WORLD);
+	MPI_Reduce(local, maximum, count, MPI_DOUBLE_INT, MPI_MAXLOC, 0, MPI_COMM_WORLD);
+	MPI_Reduce(values, sum, count, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+	if (mpi_rank == 0) {
+		for (int i = 0; i < count; i++) {
+			log(0, "range-stats %s min:%.2f (node %d) max:%.2f (node %d) avg:%.2f\n", names[i],
+					minimum[i].value, minimum[i].rank, maximum[i].value, maximum[i].rank, sum[i] / mpi_size);
+		}
+	}
+}
+
+// =========================
+// portfolio
+// =========================
+PortfolioSolverInterface* createSolver(const string& name, int slot, int totalSlots) {
+	if (name == "lingeling") {
+		return new Lingeling();
+	} else if (name == "minisat") {
+		return new MiniSat();
+	} else if (name == "candy") {
+		return new CandyHorde(slot, totalSlots);
+	} else if (name == "cadical") {
+		return new Cadical();
+	} else if (name == "kissat") {
+		return new Kissat();
+	} else if (name == "probsat") {
+		return new ProbSat(slot);
+	}
+	return NULL;
+}
+
+// Spread the solvers of all the ranks on this machine over its NUMA nodes.
+// If the launcher already bound the rank to some cores only those are used.
+void placeThreads(int mpi_rank) {
+	Topology topology;
+	MPI_Comm localComm;
+	int localRank = 0;
+	MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &localComm);
+	if (!topology.isRestricted()) {
+		MPI_Comm_rank(localComm, &localRank);
+	}
+	MPI_Comm_free(&localComm);
+	if (localRank*solversCount + solversCount > topology.getCpusCount()) {
+		log(0, "WARNING: more solvers than cpus, some solvers share a cpu\n");
+	}
+	for (int i = 0; i < solversCount; i++) {
+		int cpu = topology.getSolverCpu(localRank*solversCount + i);
+		solverCpus.push_back(cpu);
+		log(1, "Pinning solver %d of node %d to cpu %d (numa node %d of %d)\n", i, mpi_rank, cpu,
+				topology.getNode(cpu), topology.getNodesCount());
+	}
+	mainThreadCpus = topology.getNodeCpus(topology.getNode(solverCpus[0]));
+	pinCurrentThread(mainThreadCpus);
+}
+
+// Rank 0 reads the portfolio file and sends it to the others, so it does not
+// have to be on a shared file system.
+bool loadPortfolio(const char* filename, int mpi_rank) {
+	string text;
+	int len = 0;
+	if (mpi_rank == 0) {
+		if (readTextFile(filename, text)) {
+			len = text.size();
+		} else {
+			len = -1;
+		}
+	}
+	MPI_Bcast(&len, 1, MPI_INT, 0, MPI_COMM_WORLD);
+	if (len < 0) {
+		log(0, "cannot read portfolio file %s\n", filename);
+		return false;
+	}
+	text.resize(len);
+	MPI_Bcast(&text[0], len, MPI_CHAR, 0, MPI_COMM_WORLD);
+	return portfolio.parse(text);
+}
+
+// Apply the per slot settings on top of the global diversification
+void applyPortfolio(int mpi_rank, int mpi_size) {
+	int totalSlots = mpi_size * solversCount;
+	for (int sid = 0; sid < solversCount; sid++) {
+		const SlotConfig& slot = portfolio.getSlot(mpi_rank * solversCount + sid);
+		if (slot.diversify != SPEC_NOT_SET) {
+			solvers[sid]->diversify(slot.diversify, totalSlots);
+		}
+		if (slot.seed != SPEC_NOT_SET) {
+			// Candy gets the seed in its constructor
+			solvers[sid]->setOption("seed", slot.seed);
+		}
+		for (size_t i = 0; i < slot.options.size(); i++) {
+			const char* name = slot.options[i].first.c_str();
+			if (!solvers[sid]->setOption(name, slot.options[i].second)) {
+				log(0, "core %d: %s does not support option %s\n", sid, slot.solver.c_str(), name);
+			} else {
+				solverOptions[sid].push_back(slot.options[i]);
+			}
+		}
+		if (sharingManager != NULL) {
+			for (int i = 0; i < slot.production; i++) {
+				solvers[sid]->increaseClauseProduction();
+			}
+		}
+	}
+}
+
 int main(int argc, char** argv) {
 	MPI_Init(&argc, &argv);
 
@@ -161,14 +646,37 @@ int main(int argc, char** argv) {
 		puts("This is HordeSat ($Revision: 46 $)");
 		puts("USAGE: [mpirun ...] ./hordesat [parameters] input.cnf");
 		puts("Parameters:");
-		puts("        -d=0...7\t diversification 0=none, 1=sparse, 2=dense, 3=random, 4=native(plingeling), 5=1&4, 6=sparse-random, 7=6&4, default is 1.");
+		puts("        -d=0...8\t diversification 0=none, 1=sparse, 2=dense, 3=random, 4=native(plingeling), 5=1&4, 6=sparse-random, 7=6&4,");
+		puts("        \t\t 8=2&4 with sampled options for each solver (scales to any number of solvers), default is 1.");
 		puts("        -e=0,1,2\t clause exchange mode 0=none, 1=all-to-all, 2=log-partners, default is 1.");
 		puts("        -fd\t\t filter duplicate clauses.");
 		puts("        -c=<INT>\t use that many cores on each mpi node, default is 1.");
 		puts("        -v=<INT>\t verbosity level, higher means more messages, default is 1.");
 		puts("        -s=minisat\t use minisat instead of lingeling");
 		puts("        -s=candy\t use candy instead of lingeling");
+		puts("        -s=cadical\t use cadical instead of lingeling");
+		puts("        -s=kissat\t use kissat instead of lingeling (no clause sharing)");
 		puts("        -s=combo\t use both minisat and lingeling");
+		puts("        -ls=<INT>\t percentage of the cores running probSAT local search, default is 0.");
+		puts("        -lsi=<INT>\t min. seconds between giving the local search phases to the other solvers, default is 10.");
+		puts("        -cube=<INT>\t cube and conquer, split the formula into up to 2^INT cubes solved under assumptions.");
+		puts("        -pre\t\t preprocess the formula once per node (elimination, subsumption, equivalences).");
+		puts("        -fast\t\t send new units and equivalences to the other nodes within milliseconds.");
+		puts("        -ip\t\t run a thread per node vivifying the learned clauses, needs clause sharing.");
+		puts("        -model\t\t print the model if the formula is satisfiable.");
+		puts("        -pin\t\t pin the solver threads to cores spread over the NUMA nodes, the memory of each");
+		puts("        \t\t solver is allocated on the node of its core.");
+		puts("        -mem=<INT>\t memory budget of each process in MB, close to it the solvers reduce their learned");
+		puts("        \t\t clauses and the sharing buffers are shrunk, at the budget the weakest solver is stopped.");
+		puts("        -adapt=<INT>\t every INT seconds give the options of the best solver, mutated, to the worst one.");
+		puts("        -telemetry[=<PREFIX>]\t write a JSON line per round into PREFIX.<rank>.jsonl, default prefix is hordesat.");
+		puts("        -trace[=<PREFIX>]\t write the time spent in each phase of each thread to PREFIX.<rank>.trace.json");
+		puts("        \t\t (Chrome trace format, open it in Perfetto), default prefix is hordesat.");
+		puts("        -progress=<FILE>\t rank 0 keeps a snapshot of the statistics of all ranks in FILE");
+		puts("        \t\t (Prometheus text format, rewritten every few seconds).");
+		puts("        -steal\t\t with -cube, nodes with idle cores steal cubes from random other nodes.");
+		puts("        -p=<FILE>\t portfolio file with one solver slot per line, overrides -s. Line format:");
+		puts("        \t\t solver=<NAME> [seed=<INT>] [diversify=<INT>] [production=<INT>] [count=<INT>] [<OPTION>=<INT> ...]");
 		puts("        -r=<INT>\t max number of rounds (~timelimit in seconds), default is unlimited.");
 		puts("        -i=<INT>\t communication interval in miliseconds, default is 1000.");
 		puts("        -t=<INT>\t timelimit in seconds, default is unlimited.");
@@ -184,17 +692,61 @@ int main(int argc, char** argv) {
 	if (mpi_rank == 0) {
 		setVerbosityLevel(3);
 	}
+	if (params.isSet("trace")) {
+		startTracing();
+		setTraceThreadName("main");
+	}
+	startLogger(mpi_rank);
 
 	char hostname[1024];
 	gethostname(hostname, 1024);
 	log(0, "Running HordeSat ($Revision: 46 $) on %s rank %d/%d input %s with parameters: ",
 			hostname, mpi_rank, mpi_size, params.getFilename());
+	flushLog();
 	params.printParams();
 
 	solversCount = params.getIntParam("c", 1);
 
+	if (params.isSet("p")) {
+		if (!loadPortfolio(params.getParam("p").c_str(), mpi_rank)) {
+			log(0, "invalid portfolio file %s\n", params.getParam("p").c_str());
+			stopLogger();
+			MPI_Finalize();
+			return 1;
+		}
+		usePortfolio = true;
+	}
+
+	if (params.isSet("pin")) {
+		placeThreads(mpi_rank);
+	}
+
+	// the last cores of each node run local search
+	int localSearchCount = (solversCount * params.getIntParam("ls", 0) + 50) / 100;
+
 	for (int i = 0; i < solversCount; i++) {
-		if (params.getParam("s") == "minisat") {
+		// memory is placed on the NUMA node of the thread touching it first
+		if (!solverCpus.empty()) {
+			pinCurrentThread(solverCpus[i]);
+		}
+		if (usePortfolio) {
+			int slot = mpi_rank * solversCount + i;
+			const string& name = portfolio.getSlot(slot).solver;
+			int seed = portfolio.getSlot(slot).seed;
+			PortfolioSolverInterface* solver = createSolver(name, seed != SPEC_NOT_SET ? seed : slot,
+					mpi_size * solversCount);
+			if (solver == NULL) {
+				log(0, "unknown solver %s in the portfolio file\n", name.c_str());
+				stopLogger();
+				MPI_Finalize();
+				return 1;
+			}
+			solvers.push_back(solver);
+			log(1, "Running %s (portfolio slot %d) on core %d of node %d/%d\n", name.c_str(), slot, i, mpi_rank, mpi_size);
+		} else if (i >= solversCount - localSearchCount) {
+			solvers.push_back(new ProbSat(mpi_rank*solversCount+i));
+			log(1, "Running probSAT on core %d of node %d/%d\n", i, mpi_rank, mpi_size);
+		} else if (params.getParam("s") == "minisat") {
 			solvers.push_back(new MiniSat());
 			log(1, "Running MiniSat on core %d of node %d/%d\n", i, mpi_rank, mpi_size);
 		} else if (params.getParam("s") == "combo") {
@@ -210,13 +762,50 @@ int main(int argc, char** argv) {
 			solvers.push_back(new CandyHorde(mpi_rank*solversCount+i, mpi_size * solversCount));
 			log(1, "Running Candy on core %d of node %d/%d\n", i, mpi_rank, mpi_size);
 		} 
+		else if (params.getParam("s") == "cadical") {
+			solvers.push_back(new Cadical());
+			log(1, "Running CaDiCaL on core %d of node %d/%d\n", i, mpi_rank, mpi_size);
+		}
+		else if (params.getParam("s") == "kissat") {
+			solvers.push_back(new Kissat());
+			log(1, "Running Kissat on core %d of node %d/%d\n", i, mpi_rank, mpi_size);
+		}
 		else {
 			solvers.push_back(new Lingeling());
 			log(1, "Running Lingeling on core %d of node %d/%d\n", i, mpi_rank, mpi_size);
 		}
 	}
 
-	loadFormulaToSolvers(solvers, params.getFilename());
+	if (!solverCpus.empty()) {
+		pinCurrentThread(mainThreadCpus);
+	}
+
+	// with preprocessing, cubes, inprocessing or pinning the formula is read only once per node
+	usePreprocessing = params.isSet("pre");
+	cubeMode = params.isSet("cube");
+	bool useInprocessing = params.isSet("ip");
+	vector<vector<int> > formula;
+	if (usePreprocessing || cubeMode || useInprocessing || !solverCpus.empty()) {
+		readFormula(params.getFilename(), formula);
+		if (cubeMode) {
+			initializeCubes(params.getIntParam("cube", 0), mpi_rank, mpi_size, formula);
+		}
+		if (usePreprocessing && !preprocessor.preprocess(formula, solversCount)) {
+			finalResult = UNSAT;
+			solvingDoneLocal = true;
+		}
+		for (int i = 0; i < solversCount; i++) {
+			if (!solverCpus.empty()) {
+				pinCurrentThread(solverCpus[i]);
+			}
+			solvers[i]->addInitialClauses(formula);
+		}
+		if (!solverCpus.empty()) {
+			pinCurrentThread(mainThreadCpus);
+		}
+	} else {
+		loadFormulaToSolvers(solvers, params.getFilename());
+	}
 
 	int exchangeMode = params.getIntParam("e", 1);
 	if (exchangeMode == 0) {
@@ -233,7 +822,13 @@ int main(int argc, char** argv) {
 			break;
 		}
 	}
+	if (useInprocessing && sharingManager != NULL) {
+		sharingManager->startInprocessing(formula);
+		log(1, "Started the inprocessing worker.\n");
+	}
+	vector<vector<int> >().swap(formula);
 
+	solverOptions.resize(solversCount);
 	int diversification = params.getIntParam("d", 1);
 	switch (diversification) {
 	case 1:
@@ -266,12 +861,56 @@ int main(int argc, char** argv) {
 		nativeDiversification(mpi_rank, mpi_size);
 		log(1, "doing random sparse + native diversification (plingeling)\n");
 		break;
+	case 8:
+		binValueDiversification(mpi_size, mpi_rank);
+		nativeDiversification(mpi_rank, mpi_size);
+		sampledDiversification(mpi_rank, mpi_size);
+		log(1, "doing binary value + native + sampled options diversification\n");
+		break;
 	case 0:
 		log(1, "no diversification\n");
 		break;
 	}
+	if (usePortfolio) {
+		applyPortfolio(mpi_rank, mpi_size);
+		log(1, "applied the portfolio settings\n");
+	}
+
+	if (cubeMode && params.isSet("steal")) {
+		workStealingManager = new WorkStealingManager(mpi_size, mpi_rank, cubeQueue, solvers);
+		log(1, "Initialized cube work stealing.\n");
+	}
+
+	if (params.getIntParam("adapt", 0) > 0) {
+		vector<string> names;
+		for (int i = 0; i < solversCount; i++) {
+			names.push_back(getSolverName(solvers[i]));
+		}
+		adaptivePortfolio = new AdaptivePortfolio(solvers, names, solverOptions, sharingManager,
+				params.getIntParam("adapt", 0), mpi_rank);
+		log(1, "Initialized the adaptive portfolio.\n");
+	}
+
+	if (params.getIntParam("mem", 0) > 0) {
+		// the cube workers keep running, their cubes would be lost
+		vector<bool> stoppable;
+		// only these can make their clause databases smaller
+		vector<bool> reducible;
+		for (int i = 0; i < solversCount; i++) {
+			stoppable.push_back(!(cubeMode && supportsAssumptions(solvers[i])));
+			reducible.push_back(dynamic_cast<Lingeling*>(solvers[i]) != NULL || dynamic_cast<MiniSat*>(solvers[i]) != NULL);
+		}
+		memoryGovernor = new MemoryGovernor(solvers, stoppable, reducible, sharingManager,
+				params.getIntParam("mem", 0), mpi_rank);
+		log(1, "Initialized the memory governor with a budget of %d MB.\n", params.getIntParam("mem", 0));
+	}
 
 	initializeEndingDetection(mpi_size);
+	if (params.isSet("progress")) {
+		string filename = params.getParam("progress");
+		progressReporter = new ProgressReporter(filename.empty() ? "hordesat.prom" : filename, mpi_rank, mpi_size,
+				solvers, sharingManager);
+	}
 
 	Thread** solverThreads = (Thread**) malloc (solversCount*sizeof(Thread*));
 	for (int i = 0; i < solversCount; i++) {
@@ -285,47 +924,126 @@ int main(int argc, char** argv) {
 	int maxRounds = params.getIntParam("r", -1);
 	size_t sleepInt = 1000 * params.getIntParam("i", 1000);
 	int round = 1;
+	double phaseInterval = params.getIntParam("lsi", 10);
+	bool localSearch = usePortfolio || localSearchCount > 0;
 
+	bool fastSharing = sharingManager != NULL && params.isSet("fast");
+	Telemetry* telemetry = NULL;
+	if (params.isSet("telemetry")) {
+		string prefix = params.getParam("telemetry");
+		telemetry = new Telemetry(prefix.empty() ? "hordesat" : prefix, mpi_rank, solversCount);
+	}
 	while (!getGlobalEnding(mpi_size, mpi_rank)) {
-		usleep(sleepInt);
+		double sleepStart = getTime();
+		if (fastSharing) {
+			double roundEnd = getTime() + sleepInt / 1000000.0;
+			while (getTime() < roundEnd) {
+				usleep(UNIT_BROADCAST_INTERVAL);
+				sharingManager->doFastSharing();
+			}
+		} else {
+			usleep(sleepInt);
+		}
 		double timeNow = getTime();
+		if (tracingEnabled) {
+			addTraceEvent("sleep", sleepStart, timeNow);
+		}
 		log(2, "Node %d entering round %d (%.2f seconds solving, %.2f rounds/sec)\n", mpi_rank, round,
 			timeNow - startSolving, round/(timeNow - startSolving));
 		if (sharingManager != NULL) {
 			sharingManager->doSharing();
 		}
+		if (localSearch) {
+			exportLocalSearchPhases(phaseInterval);
+		}
+		if (workStealingManager != NULL) {
+			workStealingManager->doStealing();
+		}
+		if (cubeMode) {
+			checkCubes();
+		}
+		if (adaptivePortfolio != NULL) {
+			adaptivePortfolio->adapt(timeNow - startSolving);
+		}
+		if (memoryGovernor != NULL) {
+			memoryGovernor->check(round);
+		}
+		if (telemetry != NULL) {
+			telemetry->recordRound(round, timeNow, endingTime, solvers, sharingManager);
+		}
 		if (round == maxRounds || (maxSeconds != 0 && timeNow > maxSeconds)) {
 			solvingDoneLocal = true;
 		}
-		fflush(stdout);
 		round++;
 	}
 	double searchTime = getTime() - startSolving;
+	delete telemetry;
 	log(0, "node %d finished, joining solver threads\n", mpi_rank);
 	for (int i = 0; i < solversCount; i++) {
 		solverThreads[i]->join();
 	}
+	if (tracingEnabled) {
+		string prefix = params.getParam("trace");
+		char filename[1024];
+		snprintf(filename, sizeof(filename), "%s.%d.trace.json", prefix.empty() ? "hordesat" : prefix.c_str(),
+				mpi_rank);
+		writeTrace(filename, mpi_rank);
+	}
 
 	// Statistics gathering
 	// Local statistics
 	SolvingStatistics locSolveStats;
 	for (int i = 0; i < solversCount; i++) {
+		// released by the memory governor
+		if (solvers[i] == NULL) {
+			continue;
+		}
 		SolvingStatistics st = solvers[i]->getStatistics();
-		log(1, "thread-stats node:%d/%d thread:%d/%d props:%lu decs:%lu confs:%lu mem:%0.2f\n",
-				mpi_rank, mpi_size, i, solversCount, st.propagations, st.decisions, st.conflicts, st.memPeak);
+		log(1, "thread-stats node:%d/%d thread:%d/%d props:%lu decs:%lu confs:%lu restarts:%lu mem:%0.2f "
+				"mem-current:%0.2f units:%lu known-units:%lu fixed:%lu avoided-interrupts:%lu learned:%lu deleted:%lu "
+				"imported:%lu import-time:%.3f export-time:%.3f\n",
+				mpi_rank, mpi_size, i, solversCount, st.propagations, st.decisions, st.conflicts, st.restarts,
+				st.memPeak, st.memCurrent, st.importedUnits, st.knownUnits, st.fixedUnits, st.avoidedInterrupts,
+				st.learnedClauses, st.deletedClauses, st.importedClauses, st.importTime, st.exportTime);
 		locSolveStats.conflicts += st.conflicts;
 		locSolveStats.decisions += st.decisions;
 		locSolveStats.memPeak += st.memPeak;
 		locSolveStats.propagations += st.propagations;
 		locSolveStats.restarts += st.restarts;
+		locSolveStats.learnedClauses += st.learnedClauses;
+		locSolveStats.deletedClauses += st.deletedClauses;
+		locSolveStats.importedClauses += st.importedClauses;
+		// the units are shared, the threads mostly know the same ones
+		locSolveStats.fixedUnits = max(locSolveStats.fixedUnits, st.fixedUnits);
+		locSolveStats.memCurrent += st.memCurrent;
+		locSolveStats.importTime += st.importTime;
+		locSolveStats.exportTime += st.exportTime;
 	}
 	SharingStatistics locShareStats;
 	if (sharingManager != NULL) {
 		locShareStats = sharingManager->getStatistics();
 	}
-	log(1, "node-stats node:%d/%d solved:%d res:%d props:%lu decs:%lu confs:%lu mem:%0.2f shared:%lu filtered:%lu\n",
+	log(1, "node-stats node:%d/%d solved:%d res:%d props:%lu decs:%lu confs:%lu mem:%0.2f shared:%lu filtered:%lu "
+			"satisfied:%lu stripped:%lu strengthened:%lu vip:%lu fast-units:%lu fast-equivalences:%lu\n",
 			mpi_rank, mpi_size, finalResult != 0, finalResult, locSolveStats.propagations, locSolveStats.decisions,
-			locSolveStats.conflicts, locSolveStats.memPeak, locShareStats.sharedClauses, locShareStats.filteredClauses);
+			locSolveStats.conflicts, locSolveStats.memPeak, locShareStats.sharedClauses, locShareStats.filteredClauses,
+			locShareStats.satisfiedClauses, locShareStats.strippedLiterals, locShareStats.strengthenedClauses,
+			locShareStats.vipClauses, locShareStats.fastUnits, locShareStats.fastEquivalences);
+	if (adaptivePortfolio != NULL) {
+		log(1, "adapt-stats node:%d/%d reconfigurations:%d\n", mpi_rank, mpi_size,
+				adaptivePortfolio->getReconfigurations());
+	}
+	if (memoryGovernor != NULL) {
+		log(1, "memory-stats node:%d/%d reductions:%d stopped:%d peak:%.0f\n", mpi_rank, mpi_size,
+				memoryGovernor->getReductions(), memoryGovernor->getStoppedCount(), memoryGovernor->getPeakMemory());
+	}
+	if (workStealingManager != NULL) {
+		WorkStealingStatistics ws = workStealingManager->getStatistics();
+		log(1, "work-stats node:%d/%d refuted-cubes:%d splits:%d requests:%lu steals:%lu donations:%lu "
+				"split-requests:%lu idle:%.2f\n",
+				mpi_rank, mpi_size, cubeQueue.getRefutedCount(), cubeQueue.getSplitCount(), ws.requests, ws.steals,
+				ws.donations, ws.splitRequests, ws.idleTime);
+	}
 	// Global statistics
 	SatResult globalResult;
 	MPI_Reduce(&finalResult, &globalResult, 1, MPI_INT, MPI_MAX, 0, MPI_COMM_WORLD);
@@ -339,21 +1057,32 @@ int main(int argc, char** argv) {
 	MPI_Reduce(&locShareStats.importedClauses, &globShareStats.importedClauses, 1, MPI_UNSIGNED_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
 	MPI_Reduce(&locShareStats.filteredClauses, &globShareStats.filteredClauses, 1, MPI_UNSIGNED_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
 	MPI_Reduce(&locShareStats.dropped, &globShareStats.dropped, 1, MPI_UNSIGNED_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+	MPI_Reduce(&locShareStats.satisfiedClauses, &globShareStats.satisfiedClauses, 1, MPI_UNSIGNED_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+	MPI_Reduce(&locShareStats.strippedLiterals, &globShareStats.strippedLiterals, 1, MPI_UNSIGNED_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+	reduceNodeStatistics(mpi_rank, mpi_size, searchTime, locSolveStats, locShareStats);
+	vector<int> model;
+	bool hasModel = params.isSet("model") && gatherModel(mpi_rank, model);
 
 	if (mpi_rank == 0) {
 		log(0, "glob-stats nodes:%d threads:%d solved:%d res:%d rounds:%d time:%.2f mem:%0.2f MB props:%.2f decs:%.2f confs:%.2f "
-			"shared:%.2f imported:%.2f filtered:%.2f dropped:%.2f\n",
+			"shared:%.2f imported:%.2f filtered:%.2f dropped:%.2f satisfied:%.2f stripped:%.2f\n",
 			mpi_size, solversCount, globalResult != 0, globalResult, round,
 			searchTime, globSolveStats.memPeak,
 			globSolveStats.propagations/searchTime, globSolveStats.decisions/searchTime, globSolveStats.conflicts/searchTime,
-			globShareStats.sharedClauses/searchTime, globShareStats.importedClauses/searchTime, globShareStats.filteredClauses/searchTime, globShareStats.dropped/searchTime);
+			globShareStats.sharedClauses/searchTime, globShareStats.importedClauses/searchTime, globShareStats.filteredClauses/searchTime, globShareStats.dropped/searchTime,
+			globShareStats.satisfiedClauses/searchTime, globShareStats.strippedLiterals/searchTime);
 		// Logging Conventions:
 		log(0, "c CPU %.2f\n", searchTime);
 		log(0, "c conflicts %lu (%.2f)\n", globSolveStats.conflicts, globSolveStats.conflicts/searchTime);
 		if (globalResult > 0) {
 			if (globalResult == 10) log(0, "s SATISFIABLE\n");
 			if (globalResult == 20) log(0, "s UNSATISFIABLE\n");
-		} 
+		}
+		if (hasModel) {
+			flushLog();
+			printModel(model);
+			fflush(stdout);
+		}
 	}
 
 	// Cleanup
@@ -362,7 +1091,12 @@ int main(int argc, char** argv) {
 	}
 	free(solverThreads);
 	delete sharingManager;
+	delete workStealingManager;
+	delete adaptivePortfolio;
+	delete memoryGovernor;
+	delete progressReporter;
 
+	stopLogger();
 	MPI_Finalize();
 	return 0;
 }
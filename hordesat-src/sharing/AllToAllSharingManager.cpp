@@ -9,12 +9,20 @@
 #include "AllToAllSharingManager.h"
 #include <mpi.h>
 #include "../utilities/Logger.h"
+#include "../utilities/Tracer.h"
+#include <algorithm>
 
 
 AllToAllSharingManager::AllToAllSharingManager(int mpi_size, int mpi_rank,
 		vector<PortfolioSolverInterface*> solvers, ParameterProcessor& params)
-	:size(mpi_size),rank(mpi_rank),solvers(solvers),params(params),incommingBuffer(NULL),callback(*this) {
+	:size(mpi_size),rank(mpi_rank),solvers(solvers),params(params),incommingBuffer(NULL),inprocessor(NULL),
+	 unitBroadcaster(NULL),callback(*this) {
+	solverStats.resize(solvers.size());
+	removedSolvers.resize(solvers.size(), false);
 	incommingBuffer = new int[(COMM_BUFFER_SIZE)*size];
+	if (params.isSet("fast")) {
+		unitBroadcaster = new UnitBroadcastManager(mpi_size, mpi_rank, solvers, rootAssignment);
+	}
 	for (size_t i = 0; i < solvers.size(); i++) {
 		solvers[i]->setLearnedClauseCallback(&callback, i);
 		if (solvers.size() > 1) {
@@ -26,20 +34,32 @@ AllToAllSharingManager::AllToAllSharingManager(int mpi_size, int mpi_rank,
 void AllToAllSharingManager::doSharing() {
 	static int prodInc = 1;
 	static int lastInc = 0;
+	TraceSpan span("sharing");
 	if (!params.isSet("fd")) {
 		nodeFilter.clear();
 	}
 	int selectedCount;
+	// the VIP clauses are exchanged later, they count as if they were in the buffer
+	int vipUsed = cdb.getVIPSize();
 	int used = cdb.giveSelection(outBuffer, COMM_BUFFER_SIZE, &selectedCount);
 	stats.sharedClauses += selectedCount;
-	int usedPercent = (100*used)/COMM_BUFFER_SIZE;
+	int usedPercent = min(100, (100*(used + vipUsed))/COMM_BUFFER_SIZE);
+	stats.bufferFill = usedPercent;
 	if (usedPercent < 80) {
 		int increaser = lastInc++ % solvers.size();
-		solvers[increaser]->increaseClauseProduction();
+		if (!removedSolvers[increaser]) {
+			solvers[increaser]->increaseClauseProduction();
+		}
 		log(2, "Node %d production increase for %d. time, core %d will increase.\n", rank, prodInc++, increaser);
 	}
 	log(2, "Node %d filled %d%% of its learned clause buffer\n", rank, usedPercent);
+	double exchangeStart = getTime();
 	MPI_Allgather(outBuffer, COMM_BUFFER_SIZE, MPI_INT, incommingBuffer, COMM_BUFFER_SIZE, MPI_INT, MPI_COMM_WORLD);
+	double exchangeEnd = getTime();
+	stats.exchangeTime += exchangeEnd - exchangeStart;
+	if (tracingEnabled) {
+		addTraceEvent("exchange", exchangeStart, exchangeEnd);
+	}
 	if (solvers.size() > 1) {
 		// get all the clauses
 		cdb.setIncomingBuffer(incommingBuffer, COMM_BUFFER_SIZE, size, -1);
@@ -51,18 +71,28 @@ void AllToAllSharingManager::doSharing() {
 	int passedFilter = 0;
 	int failedFilter = 0;
 	long totalLen = 0;
-	vector<vector<int> > clausesToAdd;
+	exchangeVIPClauses(clausesToAdd);
 	while (cdb.getNextIncomingClause(cl)) {
 		totalLen += cl.size();
 		if (nodeFilter.registerClause(cl)) {
-			clausesToAdd.push_back(cl);
+			clausePool.append(clausesToAdd, cl);
 			passedFilter++;
 		} else {
 			failedFilter++;
 		}
 	}
+	int satisfied = rootAssignment.simplifyClauses(clausesToAdd);
+	if (satisfied > 0) {
+		log(2, "root assignment (%lu units) removed %d satisfied clauses, %lu false literals and %lu known units "
+				"stripped so far\n", rootAssignment.getUnitsCount(), satisfied, rootAssignment.getStrippedLiteralsCount(),
+				rootAssignment.getKnownUnitsCount());
+	}
+	double importStart = getTime();
 	if (solvers.size() > 1) {
 		for (size_t sid = 0; sid < solvers.size(); sid++) {
+			if (removedSolvers[sid]) {
+				continue;
+			}
 			for (size_t cid = 0; cid < clausesToAdd.size(); cid++) {
 				if (solverFilters[sid]->registerClause(clausesToAdd[cid])) {
 					solvers[sid]->addLearnedClause(clausesToAdd[cid]);
@@ -75,7 +105,17 @@ void AllToAllSharingManager::doSharing() {
 	} else {
 		solvers[0]->addLearnedClauses(clausesToAdd);
 	}
+	for (size_t sid = 0; sid < solvers.size(); sid++) {
+		if (!removedSolvers[sid]) {
+			solvers[sid]->retryImport();
+		}
+	}
+	clausePool.recycle(clausesToAdd);
+	if (tracingEnabled) {
+		addTraceEvent("import", importStart, getTime());
+	}
 	int total = passedFilter + failedFilter;
+	stats.receivedClauses += total;
 	stats.filteredClauses += failedFilter;
 	stats.importedClauses += passedFilter;
 	if (total > 0) {
@@ -86,11 +126,100 @@ void AllToAllSharingManager::doSharing() {
 
 }
 
+void AllToAllSharingManager::doFastSharing() {
+	TraceSpan span("fast sharing");
+	if (unitBroadcaster != NULL) {
+		unitBroadcaster->communicate();
+	}
+}
+
+void AllToAllSharingManager::startInprocessing(vector<vector<int> >& formula) {
+	inprocessor = new InprocessingWorker(formula, cdb);
+}
+
+// The VIP clauses of all the nodes go to all the solvers, the ones of this node
+// only if it has more solvers (like in setIncomingBuffer). The sizes are
+// exchanged first, so nothing has to be cut off.
+void AllToAllSharingManager::exchangeVIPClauses(vector<vector<int> >& clauses) {
+	TraceSpan span("vip exchange");
+	vipOutBuffer.clear();
+	stats.vipClauses += cdb.giveVIPSelection(vipOutBuffer);
+	int vipSize = vipOutBuffer.size();
+	double exchangeStart = getTime();
+	vector<int> sizes(size);
+	vector<int> offsets(size);
+	MPI_Allgather(&vipSize, 1, MPI_INT, sizes.data(), 1, MPI_INT, MPI_COMM_WORLD);
+	int total = 0;
+	for (int i = 0; i < size; i++) {
+		offsets[i] = total;
+		total += sizes[i];
+	}
+	vipIncommingBuffer.resize(total);
+	MPI_Allgatherv(vipOutBuffer.data(), vipSize, MPI_INT, vipIncommingBuffer.data(), sizes.data(),
+			offsets.data(), MPI_INT, MPI_COMM_WORLD);
+	stats.exchangeTime += getTime() - exchangeStart;
+	if (solvers.size() == 1) {
+		// the only solver already has the clauses it sent
+		vipIncommingBuffer.erase(vipIncommingBuffer.begin() + offsets[rank],
+				vipIncommingBuffer.begin() + offsets[rank] + sizes[rank]);
+		total -= sizes[rank];
+	}
+	cdb.setIncomingVIPBuffer(vipIncommingBuffer.data(), total);
+
+	vipFilter.clear();
+	vector<int> cl;
+	while (cdb.getNextIncomingVIPClause(cl)) {
+		stats.receivedClauses++;
+		if (vipFilter.registerClause(cl)) {
+			clausePool.append(clauses, cl);
+			if (inprocessor != NULL && cl.size() == 1) {
+				inprocessor->addClause(cl.data(), 1, 0);
+			}
+		}
+	}
+}
+
 SharingStatistics AllToAllSharingManager::getStatistics() {
+	stats.satisfiedClauses = rootAssignment.getSatisfiedCount();
+	stats.strippedLiterals = rootAssignment.getStrippedLiteralsCount();
+	if (inprocessor != NULL) {
+		stats.strengthenedClauses = inprocessor->getStatistics().strengthenedClauses;
+	}
+	if (unitBroadcaster != NULL) {
+		stats.fastUnits = unitBroadcaster->getStatistics().receivedUnits;
+		stats.fastEquivalences = unitBroadcaster->getStatistics().receivedEquivalences;
+	}
 	return stats;
 }
 
+SolverExportStatistics AllToAllSharingManager::getSolverStatistics(int solverId) {
+	return solverStats[solverId];
+}
+
+size_t AllToAllSharingManager::shrinkBuffers() {
+	size_t freed = clausePool.clear();
+	freed += sizeof(int)*(vipOutBuffer.capacity() + vipIncommingBuffer.capacity());
+	vector<int>().swap(vipOutBuffer);
+	vector<int>().swap(vipIncommingBuffer);
+	if (unitBroadcaster != NULL) {
+		freed += unitBroadcaster->clearBinaries();
+	}
+	return freed;
+}
+
+void AllToAllSharingManager::removeSolver(int solverId) {
+	removedSolvers[solverId] = true;
+	if (unitBroadcaster != NULL) {
+		unitBroadcaster->removeSolver(solverId);
+	}
+	if (solverFilters.size() > 0) {
+		solverFilters[solverId]->clear();
+	}
+}
+
 AllToAllSharingManager::~AllToAllSharingManager() {
+	delete inprocessor;
+	delete unitBroadcaster;
 	for (size_t i = 0; i < solverFilters.size(); i++) {
 		delete solverFilters[i];
 	}
@@ -12,10 +12,20 @@
 #include "SharingManagerInterface.h"
 #include "../utilities/ClauseDatabase.h"
 #include "../utilities/ClauseFilter.h"
+#include "../utilities/ClausePool.h"
+#include "../utilities/RootAssignment.h"
+#include "../utilities/InprocessingWorker.h"
+#include "UnitBroadcastManager.h"
 #include "../utilities/ParameterProcessor.h"
 
 
 #define COMM_BUFFER_SIZE 1500
+// units, binaries and clauses with at most this glue are sent as VIP clauses,
+// which are never dropped and reach all the solvers in the next round
+#define VIP_GLUE_LIMIT 2
+// ints of VIP clauses a node sends in a round at most (units do not count),
+// the clauses over the limit go to the size limited buffer
+#define VIP_BUFFER_SIZE 500
 
 class AllToAllSharingManager : public SharingManagerInterface {
 
@@ -25,30 +35,65 @@ protected:
 	// associated solvers
 	vector<PortfolioSolverInterface*> solvers;
 	vector<ClauseFilter*> solverFilters;
+	// written only by the callback of the given solver
+	vector<SolverExportStatistics> solverStats;
+	// the stopped solvers, they get no more clauses
+	vector<bool> removedSolvers;
 	// global parameters
 	ParameterProcessor& params;
 
 	ClauseDatabase cdb;
 	ClauseFilter nodeFilter;
+	RootAssignment rootAssignment;
 	int outBuffer[COMM_BUFFER_SIZE];
 	int* incommingBuffer;
+	vector<int> vipOutBuffer;
+	vector<int> vipIncommingBuffer;
+	// removes the VIP clauses sent by several solvers in the same round
+	ClauseFilter vipFilter;
+	// the clauses imported in a round, their vectors are reused in the next one
+	vector<vector<int> > clausesToAdd;
+	ClausePool clausePool;
+	InprocessingWorker* inprocessor;
+	UnitBroadcastManager* unitBroadcaster;
 
 	class Callback : public LearnedClauseCallback {
 	public:
 		AllToAllSharingManager& parent;
 		Callback(AllToAllSharingManager& parent):parent(parent) {
 		}
-		void processClause(vector<int>& cls, int solverId) {
+		void processClause(const int* lits, size_t len, int glue, int solverId) {
+			SolverExportStatistics& solverStats = parent.solverStats[solverId];
 			if (parent.solvers.size() > 1) {
-				parent.solverFilters[solverId]->registerClause(cls);
+				parent.solverFilters[solverId]->registerClause(lits, len);
 			}
-			if (parent.nodeFilter.registerClause(cls)) {
-				int* res = parent.cdb.addClause(cls);
-				if (res == NULL) {
+			if (len == 1) {
+				// the units known at the root were already sent, a contradicting
+				// one proves unsatisfiability and is sent like a new one
+				if (parent.rootAssignment.addUnit(lits[0]) > 0) {
+					solverStats.duplicateClauses++;
+					return;
+				}
+				if (parent.unitBroadcaster != NULL) {
+					parent.unitBroadcaster->addUnit(lits[0]);
+				}
+			} else if (len == 2 && parent.unitBroadcaster != NULL) {
+				parent.unitBroadcaster->addBinary(lits[0], lits[1]);
+			}
+			if (parent.nodeFilter.registerClause(lits, len)) {
+				solverStats.exportedClauses++;
+				solverStats.glueSum += glue;
+				bool vip = (len <= 2 || glue <= VIP_GLUE_LIMIT) &&
+						parent.cdb.addVIPClause(lits, len, glue, VIP_BUFFER_SIZE);
+				if (!vip && parent.cdb.addClause(lits, len, glue) == NULL) {
 					parent.stats.dropped++;
 				}
+				if (parent.inprocessor != NULL) {
+					parent.inprocessor->addClause(lits, len, glue);
+				}
 			} else {
 				parent.stats.filteredClauses++;
+				solverStats.duplicateClauses++;
 			}
 		}
 	};
@@ -56,11 +101,20 @@ protected:
 	Callback callback;
 	SharingStatistics stats;
 
+	// Send the VIP clauses to all the nodes (of any size, unlike the
+	// other clauses) and append the received ones to the vector
+	void exchangeVIPClauses(vector<vector<int> >& clauses);
+
 public:
 	AllToAllSharingManager(int mpi_size, int mpi_rank, vector<PortfolioSolverInterface*> solvers,
 			ParameterProcessor& params);
 	void doSharing();
+	void doFastSharing();
+	void startInprocessing(vector<vector<int> >& formula);
 	SharingStatistics getStatistics();
+	SolverExportStatistics getSolverStatistics(int solverId);
+	size_t shrinkBuffers();
+	void removeSolver(int solverId);
 	~AllToAllSharingManager();
 };
 
@@ -9,6 +9,8 @@
 #include "LogSharingManager.h"
 #include <mpi.h>
 #include "../utilities/Logger.h"
+#include "../utilities/Tracer.h"
+#include <algorithm>
 
 LogSharingManager::LogSharingManager(int mpi_size, int mpi_rank, vector<PortfolioSolverInterface*> solvers,
 			ParameterProcessor& params):AllToAllSharingManager(mpi_size, mpi_rank, solvers, params) {
@@ -28,19 +30,26 @@ void LogSharingManager::doSharing() {
 	static int round = 0;
 	static int prodInc = 1;
 	static int lastInc = 0;
+	TraceSpan span("sharing");
 	if (!params.isSet("fd")) {
 		nodeFilter.clear();
 	}
 	int selectedCount;
+	// the VIP clauses are exchanged later, they count as if they were in the buffer
+	int vipUsed = cdb.getVIPSize();
 	int used = cdb.giveSelection(outBuffer, COMM_BUFFER_SIZE, &selectedCount);
 	stats.sharedClauses += selectedCount;
-	int usedPercent = (100*used)/COMM_BUFFER_SIZE;
+	int usedPercent = min(100, (100*(used + vipUsed))/COMM_BUFFER_SIZE);
+	stats.bufferFill = usedPercent;
 	if (usedPercent < 80) {
 		int increaser = lastInc++ % solvers.size();
-		solvers[increaser]->increaseClauseProduction();
+		if (!removedSolvers[increaser]) {
+			solvers[increaser]->increaseClauseProduction();
+		}
 		log(2, "Node %d production increase for %d. time, core %d will increase.\n", rank, prodInc++, increaser);
 	}
 	log(2, "Node %d filled %d%% of its learned clause buffer\n", rank, usedPercent);
+	double exchangeStart = getTime();
 	for (int i = 0; i < exchangeCount; i++) {
 		int partner = (round - rank + size) % size;
 		if (partner == rank && (size % 2 == 0)) {
@@ -51,6 +60,11 @@ void LogSharingManager::doSharing() {
 		MPI_Sendrecv(outBuffer, COMM_BUFFER_SIZE, MPI_INT, partner, 0,
 				incommingBuffer + i*COMM_BUFFER_SIZE, COMM_BUFFER_SIZE, MPI_INT, partner, 0, MPI_COMM_WORLD, 0);
 	}
+	double exchangeEnd = getTime();
+	stats.exchangeTime += exchangeEnd - exchangeStart;
+	if (tracingEnabled) {
+		addTraceEvent("exchange", exchangeStart, exchangeEnd);
+	}
 	if (exchangeCount == 0) {
 		memcpy(incommingBuffer, outBuffer, sizeof(int)*COMM_BUFFER_SIZE);
 	}
@@ -59,18 +73,29 @@ void LogSharingManager::doSharing() {
 	int passedFilter = 0;
 	int failedFilter = 0;
 	long totalLen = 0;
-	vector<vector<int> > clausesToAdd;
+	// the VIP clauses are few, they go to all the nodes, not just the partners
+	exchangeVIPClauses(clausesToAdd);
 	while (cdb.getNextIncomingClause(cl)) {
 		totalLen += cl.size();
 		if (nodeFilter.registerClause(cl)) {
-			clausesToAdd.push_back(cl);
+			clausePool.append(clausesToAdd, cl);
 			passedFilter++;
 		} else {
 			failedFilter++;
 		}
 	}
+	int satisfied = rootAssignment.simplifyClauses(clausesToAdd);
+	if (satisfied > 0) {
+		log(2, "root assignment (%lu units) removed %d satisfied clauses, %lu false literals and %lu known units "
+				"stripped so far\n", rootAssignment.getUnitsCount(), satisfied, rootAssignment.getStrippedLiteralsCount(),
+				rootAssignment.getKnownUnitsCount());
+	}
+	double importStart = getTime();
 	if (solvers.size() > 1) {
 		for (size_t sid = 0; sid < solvers.size(); sid++) {
+			if (removedSolvers[sid]) {
+				continue;
+			}
 			for (size_t cid = 0; cid < clausesToAdd.size(); cid++) {
 				if (solverFilters[sid]->registerClause(clausesToAdd[cid])) {
 					solvers[sid]->addLearnedClause(clausesToAdd[cid]);
@@ -83,7 +108,17 @@ void LogSharingManager::doSharing() {
 	} else {
 		solvers[0]->addLearnedClauses(clausesToAdd);
 	}
+	for (size_t sid = 0; sid < solvers.size(); sid++) {
+		if (!removedSolvers[sid]) {
+			solvers[sid]->retryImport();
+		}
+	}
+	clausePool.recycle(clausesToAdd);
+	if (tracingEnabled) {
+		addTraceEvent("import", importStart, getTime());
+	}
 	int total = passedFilter + failedFilter;
+	stats.receivedClauses += total;
 	stats.filteredClauses += failedFilter;
 	stats.importedClauses += passedFilter;
 	if (total > 0) {
@@ -12,18 +12,55 @@
 #include "../solvers/PortfolioSolverInterface.h"
 
 struct SharingStatistics {
-	SharingStatistics():sharedClauses(0),importedClauses(0),filteredClauses(0),dropped(0) {}
+	SharingStatistics():sharedClauses(0),importedClauses(0),filteredClauses(0),dropped(0),
+			satisfiedClauses(0),strippedLiterals(0),strengthenedClauses(0),vipClauses(0),
+			fastUnits(0),fastEquivalences(0),receivedClauses(0),bufferFill(0),exchangeTime(0) {}
 	unsigned long sharedClauses;
 	unsigned long importedClauses;
 	unsigned long filteredClauses;
 	unsigned long dropped;
+	// incoming clauses removed/shortened by the root level assignment
+	unsigned long satisfiedClauses;
+	unsigned long strippedLiterals;
+	// learned clauses shortened by the inprocessing worker
+	unsigned long strengthenedClauses;
+	// units, binaries and low glue clauses sent in the VIP channel
+	unsigned long vipClauses;
+	// units and equivalences received in the fast side channel
+	unsigned long fastUnits;
+	unsigned long fastEquivalences;
+	// clauses that came from the exchange, before the filtering
+	unsigned long receivedClauses;
+	// percentage of the send buffer used in the last round
+	int bufferFill;
+	// seconds spent in the clause exchange communication
+	double exchangeTime;
+};
+
+// what a single solver contributed to the sharing
+struct SolverExportStatistics {
+	SolverExportStatistics():exportedClauses(0),duplicateClauses(0),glueSum(0) {}
+	// learned clauses that passed the node filter and the ones that did not
+	unsigned long exportedClauses;
+	unsigned long duplicateClauses;
+	// sum of the glue of the exported clauses, units count as 0
+	unsigned long glueSum;
 };
 
 class SharingManagerInterface {
 
 public:
 	virtual void doSharing() = 0;
+	// Called many times between two rounds for low latency exchanges
+	virtual void doFastSharing() = 0;
+	// Start a worker vivifying the learned clauses against the formula
+	virtual void startInprocessing(vector<vector<int> >& formula) = 0;
 	virtual SharingStatistics getStatistics() = 0;
+	virtual SolverExportStatistics getSolverStatistics(int solverId) = 0;
+	// Free the memory kept for reuse by the buffers, return the freed bytes
+	virtual size_t shrinkBuffers() = 0;
+	// Stop giving clauses to a solver that was stopped
+	virtual void removeSolver(int solverId) = 0;
 	virtual ~SharingManagerInterface() {};
 
 };
@@ -0,0 +1,207 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * UnitBroadcastManager.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#include "UnitBroadcastManager.h"
+#include "../utilities/Logger.h"
+#include <stdlib.h>
+#include <algorithm>
+
+// a = b is stored as (a, b) with |a| < |b| and a > 0
+static pair<int, int> makeEquivalence(int a, int b) {
+	if (abs(a) > abs(b)) {
+		swap(a, b);
+	}
+	if (a < 0) {
+		return make_pair(-a, -b);
+	}
+	return make_pair(a, b);
+}
+
+UnitBroadcastManager::UnitBroadcastManager(int mpi_size, int mpi_rank,
+		vector<PortfolioSolverInterface*> solvers, RootAssignment& rootAssignment)
+	:solvers(solvers),removedSolvers(solvers.size(), false),rootAssignment(rootAssignment) {
+	this->mpi_size = mpi_size;
+	this->mpi_rank = mpi_rank;
+	// the hypercube restricted to the existing ranks is still connected
+	for (int bit = 1; bit < mpi_size; bit <<= 1) {
+		if ((mpi_rank ^ bit) < mpi_size) {
+			neighbors.push_back(mpi_rank ^ bit);
+		}
+	}
+}
+
+void UnitBroadcastManager::addUnit(int lit) {
+	lock.lock();
+	learnedUnits.push_back(lit);
+	lock.unlock();
+}
+
+// The binaries (x y) and (-x -y) mean that x = -y
+void UnitBroadcastManager::addBinary(int lit1, int lit2) {
+	if (lit1 == lit2 || lit1 == -lit2) {
+		return;
+	}
+	pair<int, int> binary(min(lit1, lit2), max(lit1, lit2));
+	pair<int, int> opposite(min(-lit1, -lit2), max(-lit1, -lit2));
+	lock.lock();
+	if (binaries.count(opposite) > 0) {
+		learnedEquivalences.push_back(makeEquivalence(lit1, -lit2));
+	} else if (binaries.size() < UNIT_BROADCAST_MAX_BINARIES) {
+		binaries.insert(binary);
+	}
+	lock.unlock();
+}
+
+size_t UnitBroadcastManager::clearBinaries() {
+	lock.lock();
+	// a set node holds the pair, three pointers and the color
+	size_t freed = binaries.size() * (sizeof(pair<int, int>) + 4*sizeof(void*));
+	binaries.clear();
+	lock.unlock();
+	return freed;
+}
+
+bool UnitBroadcastManager::isNewUnit(int lit) {
+	size_t index = 2*abs(lit) + (lit < 0);
+	if (knownUnits.size() <= index) {
+		knownUnits.resize(2*index, false);
+	}
+	if (knownUnits[index]) {
+		return false;
+	}
+	knownUnits[index] = true;
+	return true;
+}
+
+bool UnitBroadcastManager::isNewEquivalence(pair<int, int>& eq) {
+	return knownEquivalences.insert(eq).second;
+}
+
+// Message format: number of units, the units, number of equivalences, the
+// equivalences as pairs of literals
+void UnitBroadcastManager::receive(vector<int>& units, vector<pair<int, int> >& equivalences) {
+	int flag = 0;
+	MPI_Status status;
+	MPI_Iprobe(MPI_ANY_SOURCE, TAG_UNITS, MPI_COMM_WORLD, &flag, &status);
+	vector<int> buffer;
+	while (flag) {
+		int len;
+		MPI_Get_count(&status, MPI_INT, &len);
+		buffer.resize(len);
+		MPI_Recv(buffer.data(), len, MPI_INT, status.MPI_SOURCE, TAG_UNITS, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+		int pos = 0;
+		int count = buffer[pos++];
+		for (int i = 0; i < count; i++) {
+			int lit = buffer[pos++];
+			if (isNewUnit(lit)) {
+				units.push_back(lit);
+				stats.receivedUnits++;
+			}
+		}
+		count = buffer[pos++];
+		for (int i = 0; i < count; i++) {
+			pair<int, int> eq(buffer[pos], buffer[pos+1]);
+			pos += 2;
+			if (isNewEquivalence(eq)) {
+				equivalences.push_back(eq);
+				stats.receivedEquivalences++;
+			}
+		}
+		flag = 0;
+		MPI_Iprobe(MPI_ANY_SOURCE, TAG_UNITS, MPI_COMM_WORLD, &flag, &status);
+	}
+}
+
+void UnitBroadcastManager::deliver(vector<int>& units, vector<pair<int, int> >& equivalences) {
+	vector<vector<int> > clauses;
+	for (size_t i = 0; i < units.size(); i++) {
+		rootAssignment.addUnit(units[i]);
+		clauses.push_back(vector<int>(1, units[i]));
+	}
+	// a = b as the binary clauses (-a b) and (a -b) with glue 1
+	vector<int> cls(3, 2);
+	for (size_t i = 0; i < equivalences.size(); i++) {
+		cls[1] = -equivalences[i].first;
+		cls[2] = equivalences[i].second;
+		clauses.push_back(cls);
+		cls[1] = equivalences[i].first;
+		cls[2] = -equivalences[i].second;
+		clauses.push_back(cls);
+	}
+	for (size_t sid = 0; sid < solvers.size(); sid++) {
+		if (!removedSolvers[sid]) {
+			solvers[sid]->addLearnedClauses(clauses);
+		}
+	}
+}
+
+void UnitBroadcastManager::communicate() {
+	for (list<Message*>::iterator it = unfinishedSends.begin(); it != unfinishedSends.end();) {
+		int flag = 0;
+		MPI_Test(&(*it)->request, &flag, MPI_STATUS_IGNORE);
+		if (flag) {
+			delete *it;
+			it = unfinishedSends.erase(it);
+		} else {
+			it++;
+		}
+	}
+
+	vector<int> local;
+	vector<pair<int, int> > localEquivalences;
+	lock.lock();
+	local.swap(learnedUnits);
+	localEquivalences.swap(learnedEquivalences);
+	lock.unlock();
+	vector<int> units;
+	vector<pair<int, int> > equivalences;
+	for (size_t i = 0; i < local.size(); i++) {
+		if (isNewUnit(local[i])) {
+			units.push_back(local[i]);
+		}
+	}
+	for (size_t i = 0; i < localEquivalences.size(); i++) {
+		if (isNewEquivalence(localEquivalences[i])) {
+			equivalences.push_back(localEquivalences[i]);
+		}
+	}
+	receive(units, equivalences);
+	if (units.empty() && equivalences.empty()) {
+		return;
+	}
+	deliver(units, equivalences);
+
+	vector<int> buffer;
+	buffer.push_back(units.size());
+	buffer.insert(buffer.end(), units.begin(), units.end());
+	buffer.push_back(equivalences.size());
+	for (size_t i = 0; i < equivalences.size(); i++) {
+		buffer.push_back(equivalences[i].first);
+		buffer.push_back(equivalences[i].second);
+	}
+	for (size_t i = 0; i < neighbors.size(); i++) {
+		Message* msg = new Message();
+		msg->buffer = buffer;
+		MPI_Isend(msg->buffer.data(), msg->buffer.size(), MPI_INT, neighbors[i], TAG_UNITS, MPI_COMM_WORLD, &msg->request);
+		unfinishedSends.push_back(msg);
+		stats.sentMessages++;
+	}
+	log(2, "Node %d broadcast %lu units and %lu equivalences\n", mpi_rank, units.size(), equivalences.size());
+}
+
+void UnitBroadcastManager::removeSolver(int solverId) {
+	removedSolvers[solverId] = true;
+}
+
+UnitBroadcastManager::~UnitBroadcastManager() {
+	for (list<Message*>::iterator it = unfinishedSends.begin(); it != unfinishedSends.end(); it++) {
+		MPI_Cancel(&(*it)->request);
+		MPI_Wait(&(*it)->request, MPI_STATUS_IGNORE);
+		delete *it;
+	}
+}
@@ -0,0 +1,96 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * UnitBroadcastManager.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#ifndef SHARING_UNITBROADCASTMANAGER_H_
+#define SHARING_UNITBROADCASTMANAGER_H_
+
+#include <mpi.h>
+#include <list>
+#include <set>
+#include "../solvers/PortfolioSolverInterface.h"
+#include "../utilities/RootAssignment.h"
+#include "../utilities/Threading.h"
+
+#define TAG_UNITS 103
+// microseconds between two calls of communicate by the main thread
+#define UNIT_BROADCAST_INTERVAL 5000
+// learned binary clauses remembered for finding equivalences
+#define UNIT_BROADCAST_MAX_BINARIES 1000000
+
+struct UnitBroadcastStatistics {
+	UnitBroadcastStatistics():receivedUnits(0),receivedEquivalences(0),sentMessages(0) {}
+	// new units and equivalences that came from the other nodes
+	unsigned long receivedUnits;
+	unsigned long receivedEquivalences;
+	unsigned long sentMessages;
+};
+
+/**
+ * Low latency side channel for the root level units and the equivalences
+ * (found as pairs of learned binary clauses). New knowledge is flooded over
+ * a hypercube: each node sends what it did not know before to its log(size)
+ * neighbors with non-blocking point-to-point messages, so everything reaches
+ * all the nodes in log(size) hops without waiting for the sharing round.
+ */
+class UnitBroadcastManager {
+private:
+	struct Message {
+		MPI_Request request;
+		vector<int> buffer;
+	};
+
+	int mpi_rank, mpi_size;
+	vector<int> neighbors;
+	vector<PortfolioSolverInterface*> solvers;
+	// the stopped solvers, they get no more clauses
+	vector<bool> removedSolvers;
+	RootAssignment& rootAssignment;
+	list<Message*> unfinishedSends;
+	UnitBroadcastStatistics stats;
+
+	// filled by the solver threads
+	Mutex lock;
+	vector<int> learnedUnits;
+	vector<pair<int, int> > learnedEquivalences;
+	set<pair<int, int> > binaries;
+
+	// what was already sent and given to the local solvers, main thread only
+	vector<bool> knownUnits;
+	set<pair<int, int> > knownEquivalences;
+
+	bool isNewUnit(int lit);
+	bool isNewEquivalence(pair<int, int>& eq);
+	void receive(vector<int>& units, vector<pair<int, int> >& equivalences);
+	void deliver(vector<int>& units, vector<pair<int, int> >& equivalences);
+
+public:
+	UnitBroadcastManager(int mpi_size, int mpi_rank, vector<PortfolioSolverInterface*> solvers,
+			RootAssignment& rootAssignment);
+	/**
+	 * Called by the solver threads for each learned unit and binary clause.
+	 */
+	void addUnit(int lit);
+	void addBinary(int lit1, int lit2);
+	/**
+	 * Forget the binaries collected for finding equivalences, return the
+	 * approximate number of freed bytes.
+	 */
+	size_t clearBinaries();
+	/**
+	 * Send the new knowledge to the neighbors, receive theirs and give
+	 * all of it to the local solvers. Called by the main thread.
+	 */
+	void communicate();
+	void removeSolver(int solverId);
+	UnitBroadcastStatistics getStatistics() {
+		return stats;
+	}
+	virtual ~UnitBroadcastManager();
+};
+
+#endif /* SHARING_UNITBROADCASTMANAGER_H_ */
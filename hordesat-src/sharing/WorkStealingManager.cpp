@@ -0,0 +1,123 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * WorkStealingManager.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#include "WorkStealingManager.h"
+#include "../utilities/Logger.h"
+#include "../utilities/Tracer.h"
+#include <stdlib.h>
+
+WorkStealingManager::WorkStealingManager(int mpi_size, int mpi_rank, CubeQueue& cubes,
+		vector<PortfolioSolverInterface*> solvers):cubes(cubes),solvers(solvers) {
+	this->mpi_size = mpi_size;
+	this->mpi_rank = mpi_rank;
+	requestPending = false;
+	lastRound = getTime();
+	randomSeed = mpi_rank;
+}
+
+void WorkStealingManager::send(WorkMessage* msg, int destination, int tag) {
+	MPI_Isend(msg->buffer, WORK_BUFFER_SIZE, MPI_INT, destination, tag, MPI_COMM_WORLD, &msg->request);
+	unfinishedSends.push_back(msg);
+}
+
+void WorkStealingManager::serveRequests() {
+	int flag = 0;
+	MPI_Status status;
+	MPI_Iprobe(MPI_ANY_SOURCE, TAG_WORK_REQUEST, MPI_COMM_WORLD, &flag, &status);
+	while (flag) {
+		int dummy[WORK_BUFFER_SIZE];
+		MPI_Recv(dummy, WORK_BUFFER_SIZE, MPI_INT, status.MPI_SOURCE, TAG_WORK_REQUEST, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+		// the first int is the cube size, -1 means no work
+		WorkMessage* msg = new WorkMessage();
+		vector<int> cube;
+		int worker;
+		if (cubes.donate(cube)) {
+			msg->buffer[0] = cube.size();
+			for (size_t i = 0; i < cube.size(); i++) {
+				msg->buffer[i+1] = cube[i];
+			}
+			stats.donations++;
+			log(2, "Node %d gave a cube of size %lu to %d\n", mpi_rank, cube.size(), status.MPI_SOURCE);
+		} else {
+			msg->buffer[0] = -1;
+			// prepare work for the next request
+			if (!cubes.hasIdleWorkers() && cubes.requestSplit(worker)) {
+				solvers[worker]->setSolverInterrupt();
+				stats.splitRequests++;
+			}
+		}
+		send(msg, status.MPI_SOURCE, TAG_WORK);
+		flag = 0;
+		MPI_Iprobe(MPI_ANY_SOURCE, TAG_WORK_REQUEST, MPI_COMM_WORLD, &flag, &status);
+	}
+}
+
+void WorkStealingManager::receiveWork() {
+	int flag = 0;
+	MPI_Status status;
+	MPI_Iprobe(MPI_ANY_SOURCE, TAG_WORK, MPI_COMM_WORLD, &flag, &status);
+	while (flag) {
+		int buffer[WORK_BUFFER_SIZE];
+		MPI_Recv(buffer, WORK_BUFFER_SIZE, MPI_INT, status.MPI_SOURCE, TAG_WORK, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+		requestPending = false;
+		if (buffer[0] >= 0) {
+			// the idle worker is solving the whole formula, it has to
+			// be interrupted to take the cube
+			int worker = cubes.add(vector<int>(buffer+1, buffer+1+buffer[0]));
+			if (worker >= 0) {
+				solvers[worker]->setSolverInterrupt();
+			}
+			stats.steals++;
+			log(2, "Node %d stole a cube of size %d from %d\n", mpi_rank, buffer[0], status.MPI_SOURCE);
+		}
+		flag = 0;
+		MPI_Iprobe(MPI_ANY_SOURCE, TAG_WORK, MPI_COMM_WORLD, &flag, &status);
+	}
+}
+
+void WorkStealingManager::doStealing() {
+	TraceSpan span("stealing");
+	for (list<WorkMessage*>::iterator it = unfinishedSends.begin(); it != unfinishedSends.end();) {
+		int flag = 0;
+		MPI_Test(&(*it)->request, &flag, MPI_STATUS_IGNORE);
+		if (flag) {
+			delete *it;
+			it = unfinishedSends.erase(it);
+		} else {
+			it++;
+		}
+	}
+
+	serveRequests();
+	receiveWork();
+
+	double now = getTime();
+	if (cubes.hasIdleWorkers()) {
+		stats.idleTime += now - lastRound;
+		if (!requestPending && mpi_size > 1) {
+			int victim = rand_r(&randomSeed) % (mpi_size - 1);
+			if (victim >= mpi_rank) {
+				victim++;
+			}
+			WorkMessage* msg = new WorkMessage();
+			msg->buffer[0] = 0;
+			send(msg, victim, TAG_WORK_REQUEST);
+			requestPending = true;
+			stats.requests++;
+		}
+	}
+	lastRound = now;
+}
+
+WorkStealingManager::~WorkStealingManager() {
+	for (list<WorkMessage*>::iterator it = unfinishedSends.begin(); it != unfinishedSends.end(); it++) {
+		MPI_Cancel(&(*it)->request);
+		MPI_Wait(&(*it)->request, MPI_STATUS_IGNORE);
+		delete *it;
+	}
+}
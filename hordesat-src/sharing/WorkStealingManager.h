@@ -0,0 +1,71 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * WorkStealingManager.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#ifndef SHARING_WORKSTEALINGMANAGER_H_
+#define SHARING_WORKSTEALINGMANAGER_H_
+
+#include <mpi.h>
+#include <list>
+#include "../solvers/PortfolioSolverInterface.h"
+#include "../utilities/CubeQueue.h"
+
+#define TAG_WORK_REQUEST 101
+#define TAG_WORK 102
+// the longest cube that fits into a work message
+#define WORK_BUFFER_SIZE (CUBE_WEIGHT_BITS+1)
+
+struct WorkStealingStatistics {
+	WorkStealingStatistics():requests(0),steals(0),donations(0),splitRequests(0),idleTime(0) {}
+	// steal requests sent and the successful ones
+	unsigned long requests;
+	unsigned long steals;
+	// cubes given to other nodes
+	unsigned long donations;
+	// local cubes asked to be split because there was nothing to give
+	unsigned long splitRequests;
+	// seconds spent with an empty queue and a worker without a cube
+	double idleTime;
+};
+
+struct WorkMessage {
+	MPI_Request request;
+	int buffer[WORK_BUFFER_SIZE];
+};
+
+/**
+ * Dynamic load balancing of the cubes between the nodes. A node with
+ * idle workers asks a random victim for work, the victim sends a cube from
+ * its queue or, if it has none, asks one of its workers to split its cube
+ * so the next request can be served. Called by the main thread every round.
+ */
+class WorkStealingManager {
+private:
+	int mpi_rank, mpi_size;
+	CubeQueue& cubes;
+	vector<PortfolioSolverInterface*> solvers;
+	list<WorkMessage*> unfinishedSends;
+	bool requestPending;
+	double lastRound;
+	// for choosing the victims, rand() is shared by the whole process
+	unsigned int randomSeed;
+	WorkStealingStatistics stats;
+
+	void send(WorkMessage* msg, int destination, int tag);
+	void serveRequests();
+	void receiveWork();
+
+public:
+	WorkStealingManager(int mpi_size, int mpi_rank, CubeQueue& cubes, vector<PortfolioSolverInterface*> solvers);
+	void doStealing();
+	WorkStealingStatistics getStatistics() {
+		return stats;
+	}
+	virtual ~WorkStealingManager();
+};
+
+#endif /* SHARING_WORKSTEALINGMANAGER_H_ */
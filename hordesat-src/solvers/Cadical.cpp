@@ -0,0 +1,298 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * Cadical.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#include "Cadical.h"
+#include "../utilities/SatUtils.h"
+#include "../utilities/Tracer.h"
+#include <stdlib.h>
+#include <algorithm>
+
+void Cadical::Learner::learn(int lit) {
+	if (lit != 0) {
+		cls.push_back(lit);
+		return;
+	}
+	SampledTraceSpan span("export", &parent.adapterStats.exportTime);
+	int glue = 0;
+	if (cls.size() == 1) {
+		parent.unitsToAdd.markKnown(cls[0]);
+	} else {
+		// CaDiCaL does not tell the LBD of the learned clauses, the clause
+		// size is its upper bound (see LearnedClauseCallback)
+		glue = cls.size();
+	}
+	parent.callback->processClause(cls.data(), cls.size(), glue, parent.myId);
+	cls.clear();
+}
+
+Cadical::Cadical():terminator(*this),learner(*this),importer(*this) {
+	solver = new CaDiCaL::Solver();
+	solver->connect_terminator(&terminator);
+	// also without clause sharing, the learner counts the conflicts
+	solver->connect_learner(&learner);
+	stopSolver = 0;
+	callback = NULL;
+	sizeLimit = 0;
+	myId = 0;
+	unitsPos = 0;
+	importPending = false;
+	importedLits = NULL;
+	importedUnit[1] = 0;
+	avoidedInterrupts = 0;
+	initialized = false;
+	maxVar = 0;
+	diversificationRank = -1;
+}
+
+bool Cadical::loadFormula(const char* filename) {
+	vector<PortfolioSolverInterface*> solvers;
+	solvers.push_back(this);
+	return loadFormulaToSolvers(solvers, filename);
+}
+
+int Cadical::getVariablesCount() {
+	return initialized ? solver->vars() : maxVar;
+}
+
+// Get a variable suitable for search splitting
+int Cadical::getSplittingVariable() {
+	if (!initialized) {
+		initialize();
+	}
+	return solver->lookahead();
+}
+
+// Set initial phase for a given variable
+void Cadical::setPhase(const int var, const bool phase) {
+	if (initialized) {
+		solver->phase(phase ? var : -var);
+	} else {
+		initialPhases.push_back(phase ? var : -var);
+	}
+}
+
+// Interrupt the SAT solving, so it can be started again with new assumptions
+void Cadical::setSolverInterrupt() {
+	stopSolver = 1;
+}
+void Cadical::unsetSolverInterrupt() {
+	stopSolver = 0;
+}
+
+// Solve the formula with a given set of assumptions
+// return 10 for SAT, 20 for UNSAT, 0 for UNKNOWN
+SatResult Cadical::solve(const vector<int>& assumptions) {
+	if (!initialized) {
+		initialize();
+	}
+
+	{
+		TraceSpan span("import", &adapterStats.importTime);
+		// add the clauses
+		clauseAddMutex.lock();
+		for (size_t i = 0; i < clausesToAdd.size(); i++) {
+			for (size_t j = 0; j < clausesToAdd[i].size(); j++) {
+				solver->add(clausesToAdd[i][j]);
+			}
+			solver->add(0);
+		}
+		clausesToAdd.clear();
+		clauseAddMutex.unlock();
+	}
+	// the shared clauses are imported by the importer during the search
+
+	// set the assumptions
+	for (size_t i = 0; i < assumptions.size(); i++) {
+		solver->assume(assumptions[i]);
+	}
+	int res = solver->solve();
+	switch (res) {
+	case 10:
+		return SAT;
+	case 20:
+		return UNSAT;
+	}
+	return UNKNOWN;
+}
+
+void Cadical::freezeVariable(int var) {
+	if (initialized) {
+		solver->freeze(var);
+	} else {
+		initialFrozen.push_back(var);
+	}
+}
+
+vector<int> Cadical::getSolution() {
+	vector<int> result(1, 0);
+	for (int var = 1; var <= solver->vars(); var++) {
+		result.push_back(solver->val(var) > 0 ? var : -var);
+	}
+	return result;
+}
+
+// Point importedLits to the next shared clause, called by the importer
+bool Cadical::nextImportedClause() {
+	while (true) {
+		if (unitsPos < unitsBuffer.size()) {
+			importedUnit[0] = unitsBuffer[unitsPos++];
+			importedLits = importedUnit;
+			return true;
+		}
+		int glue;
+		importedLits = learnedClausesToAdd.next(&glue);
+		if (importedLits != NULL) {
+			adapterStats.importedClauses++;
+			return true;
+		}
+		// the flag is cleared before fetching, a clause added meanwhile sets it again
+		if (!importPending.exchange(false)) {
+			return false;
+		}
+		unitsToAdd.fetch(unitsBuffer);
+		unitsPos = 0;
+	}
+}
+
+// Add a permanent clause to the formula
+void Cadical::addClause(vector<int>& clause) {
+	clauseAddMutex.lock();
+	clausesToAdd.push_back(clause);
+	clauseAddMutex.unlock();
+	setSolverInterrupt();
+}
+
+void Cadical::addClauses(vector<vector<int> >& clauses) {
+	clauseAddMutex.lock();
+	clausesToAdd.insert(clausesToAdd.end(), clauses.begin(), clauses.end());
+	clauseAddMutex.unlock();
+	setSolverInterrupt();
+}
+
+void Cadical::addInitialClauses(vector<vector<int> >& clauses) {
+	initialClauses.insert(initialClauses.end(), clauses.begin(), clauses.end());
+	for (size_t i = 0; i < clauses.size(); i++) {
+		for (size_t j = 0; j < clauses[i].size(); j++) {
+			maxVar = max(maxVar, abs(clauses[i][j]));
+		}
+	}
+}
+
+void Cadical::initialize() {
+	if (diversificationRank >= 0) {
+		int rank = diversificationRank;
+		solver->set("seed", rank);
+		switch (rank % 8) {
+			case 0: default: break;
+			case 1: solver->set("phase", 0); break;
+			case 2: solver->set("stabilizeonly", 1); break;
+			case 3: solver->set("stabilize", 0); break;
+			case 4: solver->set("shuffle", 1), solver->set("shufflerandom", 1); break;
+			case 5: solver->set("elim", 0); break;
+			case 6: solver->set("walk", 0); break;
+			case 7: solver->set("chrono", 0); break;
+		}
+	}
+	for (size_t i = 0; i < initialOptions.size(); i++) {
+		solver->set(initialOptions[i].first.c_str(), initialOptions[i].second);
+	}
+	for (size_t i = 0; i < initialClauses.size(); i++) {
+		for (size_t j = 0; j < initialClauses[i].size(); j++) {
+			solver->add(initialClauses[i][j]);
+		}
+		solver->add(0);
+	}
+	vector<vector<int> >().swap(initialClauses);
+	for (size_t i = 0; i < initialPhases.size(); i++) {
+		solver->phase(initialPhases[i]);
+	}
+	vector<int>().swap(initialPhases);
+	for (size_t i = 0; i < initialFrozen.size(); i++) {
+		solver->freeze(initialFrozen[i]);
+	}
+	vector<int>().swap(initialFrozen);
+	if (callback != NULL) {
+		solver->connect_external_propagator(&importer);
+		for (int var = 1; var <= solver->vars(); var++) {
+			solver->add_observed_var(var);
+		}
+	}
+	initialized = true;
+}
+
+// Add a learned clause to the formula
+void Cadical::addLearnedClause(vector<int>& clause) {
+	if (clause.size() == 1) {
+		unitsToAdd.add(clause[0]);
+	} else {
+		learnedClausesToAdd.add(clause);
+	}
+	importPending = true;
+	avoidedInterrupts++;
+}
+
+void Cadical::addLearnedClauses(vector<vector<int> >& clauses) {
+	for (size_t i = 0; i < clauses.size(); i++) {
+		if (clauses[i].size() == 1) {
+			unitsToAdd.add(clauses[i][0]);
+		}
+	}
+	learnedClausesToAdd.add(clauses);
+	if (!clauses.empty()) {
+		importPending = true;
+		avoidedInterrupts++;
+	}
+}
+
+void Cadical::increaseClauseProduction() {
+	sizeLimit++;
+}
+
+void Cadical::reduceMemory() {
+}
+
+void Cadical::setLearnedClauseCallback(LearnedClauseCallback* callback, int solverId) {
+	this->callback = callback;
+	sizeLimit = 3;
+	myId = solverId;
+}
+
+SolvingStatistics Cadical::getStatistics() {
+	SolvingStatistics st;
+	st.importedUnits = unitsToAdd.getImportedCount();
+	st.knownUnits = unitsToAdd.getKnownCount();
+	st.avoidedInterrupts = avoidedInterrupts;
+	// the API of CaDiCaL has no statistics getters, every conflict
+	// gives one learned clause, the other counters are not available
+	st.conflicts = adapterStats.learnedClauses + adapterStats.learnedUnits;
+	adapterStats.fill(st);
+	return st;
+}
+
+void Cadical::diversify(int rank, int size) {
+	// applied in initialize()
+	diversificationRank = rank;
+}
+
+bool Cadical::setOption(const char* name, int value) {
+	if (initialized || !CaDiCaL::Solver::is_valid_option(name)) {
+		return false;
+	}
+	// applied in initialize()
+	initialOptions.push_back(make_pair(string(name), value));
+	return true;
+}
+
+Cadical::~Cadical() {
+	solver->disconnect_terminator();
+	solver->disconnect_learner();
+	if (initialized && callback != NULL) {
+		solver->disconnect_external_propagator();
+	}
+	delete solver;
+}
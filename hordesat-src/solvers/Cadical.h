@@ -0,0 +1,169 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * Cadical.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#ifndef CADICAL_H_
+#define CADICAL_H_
+
+#include "PortfolioSolverInterface.h"
+#include <string>
+#include <atomic>
+#include "../utilities/Threading.h"
+#include "../utilities/ImportBuffer.h"
+#include "../utilities/UnitBuffer.h"
+#include "cadical.hpp"
+
+class Cadical : public PortfolioSolverInterface {
+
+private:
+	CaDiCaL::Solver* solver;
+	volatile int stopSolver;
+	LearnedClauseCallback* callback;
+	int sizeLimit;
+	int myId;
+
+	class Terminator : public CaDiCaL::Terminator {
+	public:
+		Cadical& parent;
+		Terminator(Cadical& parent):parent(parent) {
+		}
+		bool terminate() {
+			return parent.stopSolver != 0;
+		}
+	};
+
+	class Learner : public CaDiCaL::Learner {
+	public:
+		Cadical& parent;
+		vector<int> cls;
+		Learner(Cadical& parent):parent(parent) {
+		}
+		bool learning(int size) {
+			if (size == 1) {
+				parent.adapterStats.learnedUnits++;
+			} else {
+				parent.adapterStats.learnedClauses++;
+			}
+			return parent.callback != NULL && size <= parent.sizeLimit;
+		}
+		void learn(int lit);
+	};
+
+	// Imports the shared clauses during the search as redundant clauses,
+	// the clauses may only contain observed variables, so all the variables
+	// are observed (and frozen) when clause sharing is enabled
+	class Importer : public CaDiCaL::ExternalPropagator {
+	public:
+		Cadical& parent;
+		Importer(Cadical& parent):parent(parent) {
+			is_lazy = true;
+		}
+		void notify_assignment(const vector<int>& lits) {
+		}
+		void notify_new_decision_level() {
+		}
+		void notify_backtrack(size_t new_level) {
+		}
+		bool cb_check_found_model(const vector<int>& model) {
+			return true;
+		}
+		bool cb_has_external_clause(bool& is_forgettable) {
+			is_forgettable = true;
+			return parent.nextImportedClause();
+		}
+		int cb_add_external_clause_lit() {
+			int lit = *parent.importedLits;
+			if (lit != 0) {
+				parent.importedLits++;
+			}
+			return lit;
+		}
+	};
+
+	Terminator terminator;
+	Learner learner;
+	Importer importer;
+
+	// clause addition
+	Mutex clauseAddMutex;
+	vector<vector<int> > clausesToAdd;
+	ImportBuffer learnedClausesToAdd;
+	UnitBuffer unitsToAdd;
+	vector<int> unitsBuffer;
+	size_t unitsPos;
+	// set by the sharing thread when it adds clauses, checked by the
+	// solver thread at each propagation fixpoint without locking
+	atomic<bool> importPending;
+	// the remaining literals of the clause being imported
+	int* importedLits;
+	int importedUnit[2];
+	unsigned long avoidedInterrupts;
+	AdapterStatistics adapterStats;
+	bool nextImportedClause();
+
+	// CaDiCaL options can only be set before the first clause is added, so
+	// the formula, phases and diversification are kept until the first solve
+	bool initialized;
+	int maxVar;
+	int diversificationRank;
+	vector<pair<string, int> > initialOptions;
+	vector<vector<int> > initialClauses;
+	vector<int> initialPhases;
+	vector<int> initialFrozen;
+	void initialize();
+
+public:
+
+	// Load formula from a given dimacs file, return false if failed
+	bool loadFormula(const char* filename);
+
+	// Get the number of variables of the formula
+	int getVariablesCount();
+
+	// Get a variable suitable for search splitting
+	int getSplittingVariable();
+
+	// Set initial phase for a given variable
+	void setPhase(const int var, const bool phase);
+
+	// Interrupt the SAT solving, so it can be started again with new assumptions and added clauses
+	void setSolverInterrupt();
+	void unsetSolverInterrupt();
+
+	// Solve the formula with a given set of assumptions
+	SatResult solve(const vector<int>& assumptions);
+	void freezeVariable(int var);
+	vector<int> getSolution();
+
+	// Add a (list of) permanent clause(s) to the formula
+	void addClause(vector<int>& clause);
+	void addClauses(vector<vector<int> >& clauses);
+	void addInitialClauses(vector<vector<int> >& clauses);
+
+	// Add a (list of) learned clause(s) to the formula
+	// The learned clauses might be added later or possibly never
+	void addLearnedClause(vector<int>& clauses);
+	void addLearnedClauses(vector<vector<int> >& clauses);
+
+	// Set a function that should be called for each learned clause
+	void setLearnedClauseCallback(LearnedClauseCallback* callback, int solverId);
+
+	// Request the solver to produce more clauses
+	void increaseClauseProduction();
+	void reduceMemory();
+
+	// Get solver statistics
+	SolvingStatistics getStatistics();
+
+	void diversify(int rank, int size);
+	bool setOption(const char* name, int value);
+
+	Cadical();
+	~Cadical();
+};
+
+#endif /* CADICAL_H_ */
@@ -8,6 +8,8 @@
 
 #include "CandyHorde.h"
 #include "../utilities/DebugUtils.h"
+#include "../utilities/Logger.h"
+#include "../utilities/Tracer.h"
 
 #include "candy/core/CNFProblem.h"
 
@@ -34,6 +36,9 @@ CandyHorde::CandyHorde(int rank, int size) : random_seed(rank), interrupted(fals
 	learnedLimit = 0;
 	myId = 0;
 	callback = NULL;
+	lastImportTime = 0;
+	importPostponed = false;
+	avoidedInterrupts = 0;
 }
 
 CandyHorde::~CandyHorde() {
@@ -135,10 +140,13 @@ int CandyHorde::interruptedCallback(void* this_pointer) {
 // Solve the formula with a given set of assumptions
 // return 10 for SAT, 20 for UNSAT, 0 for UNKNOWN
 SatResult CandyHorde::solve(const vector<int>& assumptions) {
+	double importStart = getTime();
 	clauseAddingLock.lock();
 
 	CNFProblem problem, learnts;	
 	Cl converted;
+	bool newProblemClauses = !clausesToAdd.empty();
+	bool newLearnedClauses = false;
 
 	for (std::vector<int> clause : clausesToAdd) {
 		converted = convertLiterals(clause);
@@ -146,15 +154,40 @@ SatResult CandyHorde::solve(const vector<int>& assumptions) {
 	}
 	clausesToAdd.clear();
 
-	for (std::vector<int> clause : learnedClausesToAdd) {
-		converted = convertLiterals(clause);
+	if (unitsToAdd.fetch(unitsBuffer) > 0) {
+		newProblemClauses = true;
+		for (int unit : unitsBuffer) {
+			problem.readClause({ CANDY_LIT(unit) });
+		}
+	}
+
+	int glue;
+	int* cls;
+	while ((cls = learnedClausesToAdd.next(&glue)) != NULL) {
+		converted.clear();
+		for (; *cls != 0; cls++) {
+			converted.push_back(CANDY_LIT(*cls));
+		}
 		learnts.readClause(converted);
+		adapterStats.importedClauses++;
+		newLearnedClauses = true;
 	}
-	learnedClausesToAdd.clear();
 
-	solver->init(problem, nullptr, true); // add lemma clauses
-	solver->init(learnts, nullptr, false); // add learnt clauses
+	// re-initializing the solver is expensive, only do it if there is something new
+	if (newProblemClauses) {
+		solver->init(problem, nullptr, true); // add lemma clauses
+	}
+	if (newLearnedClauses) {
+		solver->init(learnts, nullptr, false); // add learnt clauses
+	}
+	importPostponed = false;
+	double importEnd = getTime();
+	lastImportTime = importEnd;
 	clauseAddingLock.unlock();
+	adapterStats.importTime += importEnd - importStart;
+	if (tracingEnabled) {
+		addTraceEvent("import", importStart, importEnd);
+	}
 
 	converted = convertLiterals(assumptions);
 	solver->getAssignment().setAssumptions(converted);
@@ -169,6 +202,16 @@ SatResult CandyHorde::solve(const vector<int>& assumptions) {
 	return UNKNOWN;
 }
 
+std::vector<int> CandyHorde::getSolution() {
+	std::vector<int> result(1, 0);
+	Cl model = solver->getModel();
+	for (size_t i = 0; i < model.size(); i++) {
+		int var = model[i].var() + 1;
+		result.push_back(model[i].sign() ? -var : var);
+	}
+	return result;
+}
+
 void CandyHorde::addClause(vector<int>& clause) {
 	clauseAddingLock.lock();
 	clausesToAdd.push_back(clause);
@@ -177,14 +220,32 @@ void CandyHorde::addClause(vector<int>& clause) {
 }
 
 void CandyHorde::addLearnedClause(vector<int>& clause) {
-	clauseAddingLock.lock();
 	if (clause.size() == 1) {
-		clausesToAdd.push_back(clause);
-	} else {
-		learnedClausesToAdd.push_back(clause);
+		if (unitsToAdd.add(clause[0])) {
+			requestImport();
+		}
+		return;
 	}
-	clauseAddingLock.unlock();
-	if (learnedClausesToAdd.size() > CLS_COUNT_INTERRUPT_LIMIT) {
+	learnedClausesToAdd.add(clause);
+	if (learnedClausesToAdd.getPendingCount() > CLS_COUNT_INTERRUPT_LIMIT) {
+		requestImport();
+	}
+}
+
+void CandyHorde::requestImport() {
+	if (interrupted) {
+		return;
+	}
+	if (getTime() - lastImportTime < CANDY_IMPORT_INTERVAL) {
+		avoidedInterrupts++;
+		importPostponed = true;
+		return;
+	}
+	setSolverInterrupt();
+}
+
+void CandyHorde::retryImport() {
+	if (importPostponed && getTime() - lastImportTime >= CANDY_IMPORT_INTERVAL) {
 		setSolverInterrupt();
 	}
 }
@@ -210,35 +271,38 @@ void CandyHorde::addInitialClauses(vector<vector<int>>& clauses) {
 }
 
 void CandyHorde::addLearnedClauses(vector<vector<int> >& clauses) {
-	clauseAddingLock.lock();
+	bool newUnits = false;
 	for (size_t i = 0; i < clauses.size(); i++) {
-		if (clauses[i].size() == 1) {
-			clausesToAdd.push_back(clauses[i]);
-		} else {
-			learnedClausesToAdd.push_back(clauses[i]);
+		if (clauses[i].size() == 1 && unitsToAdd.add(clauses[i][0])) {
+			newUnits = true;
 		}
 	}
-	clauseAddingLock.unlock();
-	if (learnedClausesToAdd.size() > CLS_COUNT_INTERRUPT_LIMIT || clausesToAdd.size() > 0) {
-		setSolverInterrupt();
+	learnedClausesToAdd.add(clauses);
+	if (learnedClausesToAdd.getPendingCount() > CLS_COUNT_INTERRUPT_LIMIT || newUnits) {
+		requestImport();
 	}
 }
 
 void learnCallback(void* state, int* clause) {
 	CandyHorde* mp = (CandyHorde*)state;
+	SampledTraceSpan span("export", &mp->adapterStats.exportTime);
 
-	std::vector<int> ncls;
-
-	for (int i = 0; clause[i] != 0; i++) {
-		ncls.push_back(clause[i]);
+	size_t len = 0;
+	while (clause[len] != 0) {
+		len++;
 	}
 
-	if (ncls.size() > 1) {
-		int glue = std::min(3, (int)ncls.size());
-		ncls.insert(ncls.begin(), glue);
+	// Candy's callback does not provide the LBD, the clause size is its upper bound
+	int glue = 0;
+	if (len > 1) {
+		glue = len;
+		mp->adapterStats.learnedClauses++;
+	} else {
+		mp->adapterStats.learnedUnits++;
+		mp->unitsToAdd.markKnown(clause[0]);
 	}
 
-	mp->callback->processClause(ncls, mp->myId);
+	mp->callback->processClause(clause, len, glue, mp->myId);
 }
 
 void CandyHorde::setLearnedClauseCallback(LearnedClauseCallback* callback, int solverId) {
@@ -253,12 +317,20 @@ void CandyHorde::increaseClauseProduction() {
 	solver->setLearntCallback((void*)this, this->learnedLimit, learnCallback);
 }
 
+void CandyHorde::reduceMemory() {
+}
+
 SolvingStatistics CandyHorde::getStatistics() {
 	SolvingStatistics st;
-	// st.conflicts = solver->conflicts;
-	// st.propagations = solver->propagations;
-	// st.restarts = solver->starts;
-	// st.decisions = solver->decisions;
-	// st.memPeak = memUsedPeak();
+	Candy::Statistics& candyStats = solver->getStatistics();
+	st.conflicts = candyStats.nConflicts();
+	st.propagations = candyStats.nPropagations();
+	st.restarts = candyStats.nRestarts();
+	st.decisions = candyStats.nDecisions();
+	st.importedUnits = unitsToAdd.getImportedCount();
+	st.knownUnits = unitsToAdd.getKnownCount();
+	st.avoidedInterrupts = avoidedInterrupts;
+	// only the clauses up to the export size limit are reported to the adapter
+	adapterStats.fill(st);
 	return st;
 }
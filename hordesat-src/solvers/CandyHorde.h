@@ -10,11 +10,17 @@
 #define CANDY_H_
 
 #include "PortfolioSolverInterface.h"
+#include <atomic>
 #include "../utilities/Threading.h"
+#include "../utilities/UnitBuffer.h"
+#include "../utilities/ImportBuffer.h"
 #include "candy/core/CandySolverInterface.h"
 #include "candy/systems/branching/BranchingDiversificationInterface.h"
 
 #define CLS_COUNT_INTERRUPT_LIMIT 300
+// Candy has no in-search import hook, the solver is interrupted
+// to import clauses at most once per this many seconds
+#define CANDY_IMPORT_INTERVAL 5
 
 class CandyHorde : public PortfolioSolverInterface {
 
@@ -22,17 +28,27 @@ private:
 	Candy::CandySolverInterface* solver;
 	Candy::BranchingDiversificationInterface* branching;
 
-	std::vector< std::vector<int> > learnedClausesToAdd;
+	ImportBuffer learnedClausesToAdd;
 	std::vector< std::vector<int> > clausesToAdd;
+	UnitBuffer unitsToAdd;
+	std::vector<int> unitsBuffer;
 	Mutex clauseAddingLock;
 	int learnedLimit;
 	int random_seed;
-	friend void learnCallback(const std::vector<Candy::Lit,int>& cls, void* issuer);
+	friend void learnCallback(void* state, int* clause);
 	friend std::vector<Candy::Lit> convertLiterals(std::vector<int> int_lits);
 
 	Candy::CandySolverInterface* initCandyThread(unsigned int num);
 	bool interrupted = false;
 
+	// written by the solver thread, read by the sharing thread
+	std::atomic<double> lastImportTime;
+	// an import was postponed by the rate limit and not done since
+	std::atomic<bool> importPostponed;
+	unsigned long avoidedInterrupts;
+	AdapterStatistics adapterStats;
+	void requestImport();
+
 public:
 	int myId;
 	LearnedClauseCallback* callback;
@@ -41,6 +57,8 @@ public:
 	virtual ~CandyHorde();
 
 	void diversify(int rank, int size) {}
+	// Candy options are global and are applied in the constructor
+	bool setOption(const char* name, int value) { return false; }
 
 	bool loadFormula(const char* filename);
 	//Get the number of variables of the formula
@@ -58,6 +76,9 @@ public:
 	// Solve the formula with a given set of assumptions
 	// return 10 for SAT, 20 for UNSAT, 0 for UNKNOWN
 	SatResult solve(const std::vector<int>& assumptions);
+	// variable elimination is disabled for Candy
+	void freezeVariable(int var) {}
+	std::vector<int> getSolution();
 
 	// Add a (list of) permanent clause(s) to the formula
 	void addClause(std::vector<int>& clause);
@@ -68,12 +89,14 @@ public:
 	// The learned clauses might be added later or possibly never
 	void addLearnedClause(std::vector<int>& clauses);
 	void addLearnedClauses(std::vector<std::vector<int> >& clauses);
+	void retryImport();
 
 	// Set a function that should be called for each learned clause
 	void setLearnedClauseCallback(LearnedClauseCallback* callback, int solverId);
 
 	// Request the solver to produce more clauses
 	void increaseClauseProduction();
+	void reduceMemory();
 
 	// Get solver statistics
 	SolvingStatistics getStatistics();
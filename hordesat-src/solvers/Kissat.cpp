@@ -0,0 +1,177 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * Kissat.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#include "Kissat.h"
+#include "../utilities/SatUtils.h"
+#include "../utilities/Logger.h"
+#include <stdlib.h>
+#include <algorithm>
+
+extern "C" {
+	#include "kissat.h"
+}
+
+int kissatTermCallback(void* solverPtr) {
+	Kissat* kp = (Kissat*)solverPtr;
+	return kp->stopSolver;
+}
+
+Kissat::Kissat() {
+	solver = kissat_init();
+	kissat_set_terminate(solver, this, kissatTermCallback);
+	stopSolver = 0;
+	solved = false;
+	maxVar = 0;
+	diversificationRank = -1;
+	ignoredClauses = 0;
+}
+
+bool Kissat::loadFormula(const char* filename) {
+	vector<PortfolioSolverInterface*> solvers;
+	solvers.push_back(this);
+	return loadFormulaToSolvers(solvers, filename);
+}
+
+int Kissat::getVariablesCount() {
+	return maxVar;
+}
+
+// Get a variable suitable for search splitting
+int Kissat::getSplittingVariable() {
+	// not supported by the Kissat API
+	return 0;
+}
+
+// Set initial phase for a given variable
+void Kissat::setPhase(const int var, const bool phase) {
+	// Kissat only has a global initial phase option
+}
+
+// Interrupt the SAT solving
+void Kissat::setSolverInterrupt() {
+	stopSolver = 1;
+}
+void Kissat::unsetSolverInterrupt() {
+	stopSolver = 0;
+}
+
+// Solve the formula, Kissat does not support assumptions
+// return 10 for SAT, 20 for UNSAT, 0 for UNKNOWN
+SatResult Kissat::solve(const vector<int>& assumptions) {
+	if (solved || !assumptions.empty()) {
+		return UNKNOWN;
+	}
+	solved = true;
+	if (diversificationRank >= 0) {
+		int rank = diversificationRank;
+		kissat_set_option(solver, "seed", rank);
+		switch (rank % 4) {
+			case 0: default: break;
+			case 1: kissat_set_configuration(solver, "sat"); break;
+			case 2: kissat_set_configuration(solver, "unsat"); break;
+			case 3: kissat_set_option(solver, "phase", 0); break;
+		}
+	}
+	for (size_t i = 0; i < initialOptions.size(); i++) {
+		kissat_set_option(solver, initialOptions[i].first.c_str(), initialOptions[i].second);
+	}
+	for (size_t i = 0; i < initialClauses.size(); i++) {
+		for (size_t j = 0; j < initialClauses[i].size(); j++) {
+			kissat_add(solver, initialClauses[i][j]);
+		}
+		kissat_add(solver, 0);
+	}
+	vector<vector<int> >().swap(initialClauses);
+	int res = kissat_solve(solver);
+	switch (res) {
+	case 10:
+		return SAT;
+	case 20:
+		return UNSAT;
+	}
+	return UNKNOWN;
+}
+
+// Kissat does not support assumptions
+void Kissat::freezeVariable(int var) {
+}
+
+// Kissat is not incremental, clauses can only be added before solving
+void Kissat::addClause(vector<int>& clause) {
+	if (solved) {
+		ignoredClauses++;
+		return;
+	}
+	initialClauses.push_back(clause);
+}
+
+vector<int> Kissat::getSolution() {
+	vector<int> result(1, 0);
+	for (int var = 1; var <= maxVar; var++) {
+		result.push_back(kissat_value(solver, var) > 0 ? var : -var);
+	}
+	return result;
+}
+
+void Kissat::addClauses(vector<vector<int> >& clauses) {
+	for (size_t i = 0; i < clauses.size(); i++) {
+		addClause(clauses[i]);
+	}
+}
+
+void Kissat::addInitialClauses(vector<vector<int> >& clauses) {
+	initialClauses.insert(initialClauses.end(), clauses.begin(), clauses.end());
+	for (size_t i = 0; i < clauses.size(); i++) {
+		for (size_t j = 0; j < clauses[i].size(); j++) {
+			maxVar = max(maxVar, abs(clauses[i][j]));
+		}
+	}
+}
+
+void Kissat::addLearnedClause(vector<int>& clause) {
+	ignoredClauses++;
+}
+
+void Kissat::addLearnedClauses(vector<vector<int> >& clauses) {
+	ignoredClauses += clauses.size();
+}
+
+void Kissat::increaseClauseProduction() {
+}
+
+void Kissat::reduceMemory() {
+}
+
+void Kissat::setLearnedClauseCallback(LearnedClauseCallback* callback, int solverId) {
+	log(1, "Kissat solver %d does not export learned clauses\n", solverId);
+}
+
+// The API of Kissat has no statistics getters, its counters and memory
+// are not available
+SolvingStatistics Kissat::getStatistics() {
+	SolvingStatistics st;
+	return st;
+}
+
+void Kissat::diversify(int rank, int size) {
+	// applied when solving starts
+	diversificationRank = rank;
+}
+
+bool Kissat::setOption(const char* name, int value) {
+	if (solved) {
+		return false;
+	}
+	// applied when solving starts, the API cannot tell if the option exists
+	initialOptions.push_back(make_pair(string(name), value));
+	return true;
+}
+
+Kissat::~Kissat() {
+	kissat_release(solver);
+}
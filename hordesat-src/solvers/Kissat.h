@@ -0,0 +1,87 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * Kissat.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#ifndef KISSAT_H_
+#define KISSAT_H_
+
+#include "PortfolioSolverInterface.h"
+#include <string>
+
+struct kissat;
+
+/**
+ * Kissat is not incremental and its API has no callbacks for learned clauses,
+ * so it runs in the portfolio without clause sharing and can be solved only once.
+ */
+class Kissat : public PortfolioSolverInterface {
+
+private:
+	kissat* solver;
+	int stopSolver;
+	bool solved;
+	int maxVar;
+	int diversificationRank;
+	vector<pair<string, int> > initialOptions;
+	unsigned long ignoredClauses;
+	// the options can only be set before the first clause is added,
+	// so the formula is kept until solving starts
+	vector<vector<int> > initialClauses;
+
+	friend int kissatTermCallback(void* solverPtr);
+
+public:
+
+	// Load formula from a given dimacs file, return false if failed
+	bool loadFormula(const char* filename);
+
+	// Get the number of variables of the formula
+	int getVariablesCount();
+
+	// Get a variable suitable for search splitting
+	int getSplittingVariable();
+
+	// Set initial phase for a given variable
+	void setPhase(const int var, const bool phase);
+
+	// Interrupt the SAT solving
+	void setSolverInterrupt();
+	void unsetSolverInterrupt();
+
+	// Solve the formula with a given set of assumptions
+	SatResult solve(const vector<int>& assumptions);
+	void freezeVariable(int var);
+	vector<int> getSolution();
+
+	// Add a (list of) permanent clause(s) to the formula
+	void addClause(vector<int>& clause);
+	void addClauses(vector<vector<int> >& clauses);
+	void addInitialClauses(vector<vector<int> >& clauses);
+
+	// Add a (list of) learned clause(s) to the formula
+	// The learned clauses might be added later or possibly never
+	void addLearnedClause(vector<int>& clauses);
+	void addLearnedClauses(vector<vector<int> >& clauses);
+
+	// Set a function that should be called for each learned clause
+	void setLearnedClauseCallback(LearnedClauseCallback* callback, int solverId);
+
+	// Request the solver to produce more clauses
+	void increaseClauseProduction();
+	void reduceMemory();
+
+	// Get solver statistics
+	SolvingStatistics getStatistics();
+
+	void diversify(int rank, int size);
+	bool setOption(const char* name, int value);
+
+	Kissat();
+	~Kissat();
+};
+
+#endif /* KISSAT_H_ */
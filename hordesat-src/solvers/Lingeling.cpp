@@ -8,7 +8,9 @@
 
 #include "Lingeling.h"
 #include <ctype.h>
+#include <algorithm>
 #include "../utilities/DebugUtils.h"
+#include "../utilities/Tracer.h"
 
 extern "C" {
 	#include "lglib.h"
@@ -20,10 +22,11 @@ int termCallback(void* solverPtr) {
 }
 
 void produceUnit(void* sp, int lit) {
-	vector<int> vcls;
-	vcls.push_back(lit);
 	Lingeling* lp = (Lingeling*)sp;
-	lp->callback->processClause(vcls, lp->myId);
+	SampledTraceSpan span("export", &lp->adapterStats.exportTime);
+	lp->adapterStats.learnedUnits++;
+	lp->unitsToAdd.markKnown(lit);
+	lp->callback->processClause(&lit, 1, 0, lp->myId);
 }
 
 void produce(void* sp, int* cls, int glue) {
@@ -33,69 +36,41 @@ void produce(void* sp, int* cls, int glue) {
 		return;
 	}
 	Lingeling* lp = (Lingeling*)sp;
+	lp->adapterStats.learnedClauses++;
 	if (glue > lp->glueLimit) {
 		return;
 	}
-	vector<int> vcls;
-	// to avoid zeros in the array, 1 is added to the glue
-	vcls.push_back(1+glue);
-	int i = 0;
-	while (cls[i] != 0) {
-		vcls.push_back(cls[i]);
-		i++;
+	SampledTraceSpan span("export", &lp->adapterStats.exportTime);
+	size_t len = 0;
+	while (cls[len] != 0) {
+		len++;
 	}
-	//printf("glue = %d, size = %lu\n", glue, vcls.size());
-	lp->callback->processClause(vcls, lp->myId);
+	lp->callback->processClause(cls, len, glue, lp->myId);
 }
 
 void consumeUnits(void* sp, int** start, int** end) {
 	Lingeling* lp = (Lingeling*)sp;
-
-	if (lp->unitsToAdd.empty() || (lp->clauseAddMutex.tryLock() == false)) {
-		*start = lp->unitsBuffer;
-		*end = lp->unitsBuffer;
-		return;
-	}
-	if (lp->unitsToAdd.size() >= lp->unitsBufferSize) {
-		lp->unitsBufferSize = 2*lp->unitsToAdd.size();
-		lp->unitsBuffer = (int*)realloc((void*)lp->unitsBuffer, lp->unitsBufferSize * sizeof(int));
-	}
-
-	for (size_t i = 0; i < lp->unitsToAdd.size(); i++) {
-		lp->unitsBuffer[i] = lp->unitsToAdd[i];
+	TraceSpan span("import units", &lp->adapterStats.importTime);
+	if (lp->phasesToSet.fetch(lp->phasesBuffer)) {
+		for (size_t i = 0; i < lp->phasesBuffer.size(); i++) {
+			lglsetphase(lp->solver, lp->phasesBuffer[i]);
+		}
 	}
-
-	*start = lp->unitsBuffer;
-	*end = *start + lp->unitsToAdd.size();
-	lp->clauseAddMutex.unlock();
+	size_t count = lp->unitsToAdd.fetch(lp->unitsBuffer);
+	*start = lp->unitsBuffer.data();
+	*end = *start + count;
 }
 
 void consumeCls(void* sp, int** clause, int* glue) {
 	Lingeling* lp = (Lingeling*)sp;
-
-	if (lp->learnedClausesToAdd.empty()) {
-		*clause = NULL;
-		return;
+	SampledTraceSpan span("import clause", &lp->adapterStats.importTime);
+	int storedGlue;
+	*clause = lp->learnedClausesToAdd.next(&storedGlue);
+	if (*clause != NULL) {
+		lp->adapterStats.importedClauses++;
+		// to avoid zeros in the array, 1 was added to the glue
+		*glue = storedGlue-1;
 	}
-	if (lp->clauseAddMutex.tryLock() == false) {
-		*clause = NULL;
-		return;
-	}
-	vector<int> cls = lp->learnedClausesToAdd.back();
-	lp->learnedClausesToAdd.pop_back();
-
-	if (cls.size()+1 >= lp->clsBufferSize) {
-		lp->clsBufferSize = 2*cls.size();
-		lp->clsBuffer = (int*)realloc((void*)lp->clsBuffer, lp->clsBufferSize * sizeof(int));
-	}
-	// to avoid zeros in the array, 1 was added to the glue
-	*glue = cls[0]-1;
-	for (size_t i = 1; i < cls.size(); i++) {
-		lp->clsBuffer[i-1] = cls[i];
-	}
-	lp->clsBuffer[cls.size()-1] = 0;
-	*clause = lp->clsBuffer;
-	lp->clauseAddMutex.unlock();
 }
 
 Lingeling::Lingeling() {
@@ -109,9 +84,6 @@ Lingeling::Lingeling() {
 	lglseterm(solver, termCallback, this);
 	glueLimit = 2;
 
-	unitsBufferSize = clsBufferSize = 100;
-	unitsBuffer = (int*) malloc(unitsBufferSize*sizeof(int));
-	clsBuffer = (int*) malloc(clsBufferSize*sizeof(int));
 	myId = 0;
 
 }
@@ -132,6 +104,13 @@ int Lingeling::getSplittingVariable() {
 	return lglookahead(solver);
 }
 
+int Lingeling::getSplittingVariable(const vector<int>& assumptions) {
+	for (size_t i = 0; i < assumptions.size(); i++) {
+		lglassume(solver, assumptions[i]);
+	}
+	return lglookahead(solver);
+}
+
 // Set initial phase for a given variable
 void Lingeling::setPhase(const int var, const bool phase) {
 	lglsetphase(solver, phase ? var : -var);
@@ -175,6 +154,18 @@ SatResult Lingeling::solve(const vector<int>& assumptions) {
 	return UNKNOWN;
 }
 
+void Lingeling::freezeVariable(int var) {
+	lglfreeze(solver, var);
+}
+
+vector<int> Lingeling::getSolution() {
+	vector<int> result(1, 0);
+	for (int var = 1; var <= lglmaxvar(solver); var++) {
+		result.push_back(lglderef(solver, var) > 0 ? var : -var);
+	}
+	return result;
+}
+
 // Add a permanent clause to the formula
 void Lingeling::addClause(vector<int>& clause) {
 	clauseAddMutex.lock();
@@ -200,31 +191,38 @@ void Lingeling::addInitialClauses(vector<vector<int> >& clauses) {
 
 // Add a learned clause to the formula
 void Lingeling::addLearnedClause(vector<int>& clause) {
-	clauseAddMutex.lock();
 	if (clause.size() == 1) {
-		unitsToAdd.push_back(clause[0]);
+		unitsToAdd.add(clause[0]);
 	} else {
-		learnedClausesToAdd.push_back(clause);
+		learnedClausesToAdd.add(clause);
 	}
-	clauseAddMutex.unlock();
 }
 
 void Lingeling::addLearnedClauses(vector<vector<int> >& clauses) {
-	clauseAddMutex.lock();
 	for (size_t i = 0; i < clauses.size(); i++) {
 		if (clauses[i].size() == 1) {
-			unitsToAdd.push_back(clauses[i][0]);
-		} else {
-			learnedClausesToAdd.push_back(clauses[i]);
+			unitsToAdd.add(clauses[i][0]);
 		}
 	}
-	clauseAddMutex.unlock();
+	learnedClausesToAdd.add(clauses);
+}
+
+// taken by consumeUnits at the next import point
+void Lingeling::setPendingPhases(const vector<int>& phases) {
+	phasesToSet.set(phases);
 }
 
 void Lingeling::increaseClauseProduction() {
 	glueLimit++;
 }
 
+// Reduce the learned clauses twice as often (not below the smallest
+// diversification value) and drop the cached formulas
+void Lingeling::reduceMemory() {
+	lglsetopt(solver, "reduceinc", max(lglgetopt(solver, "reduceinc") / 2, 100));
+	lglreducecache(solver);
+}
+
 void Lingeling::setLearnedClauseCallback(LearnedClauseCallback* callback, int solverId) {
 	this->callback = callback;
 	lglsetproducecls(solver, produce, this);
@@ -240,6 +238,11 @@ SolvingStatistics Lingeling::getStatistics() {
 	st.decisions = lglgetdecs(solver);
 	st.propagations = lglgetprops(solver);
 	st.memPeak = lglmaxmb(solver);
+	st.memCurrent = lglmb(solver);
+	st.importedUnits = unitsToAdd.getImportedCount();
+	st.knownUnits = unitsToAdd.getKnownCount();
+	// the API has no restart and reduce counters
+	adapterStats.fill(st);
 	return st;
 }
 
@@ -271,11 +274,17 @@ void Lingeling::diversify(int rank, int size) {
 	}
 }
 
+bool Lingeling::setOption(const char* name, int value) {
+	if (!lglhasopt(solver, name)) {
+		return false;
+	}
+	lglsetopt(solver, name, value);
+	return true;
+}
+
 
 
 Lingeling::~Lingeling() {
 	lglrelease(solver);
-	free(unitsBuffer);
-	free(clsBuffer);
 }
 
@@ -12,6 +12,9 @@
 #include "../utilities/SatUtils.h"
 #include "PortfolioSolverInterface.h"
 #include "../utilities/Threading.h"
+#include "../utilities/ImportBuffer.h"
+#include "../utilities/UnitBuffer.h"
+#include "../utilities/PhaseBuffer.h"
 
 struct LGL;
 
@@ -34,12 +37,12 @@ private:
 
 	// clause addition
 	vector<vector<int> > clausesToAdd;
-	vector<vector<int> > learnedClausesToAdd;
-	vector<int> unitsToAdd;
-	int* unitsBuffer;
-	size_t unitsBufferSize;
-	int* clsBuffer;
-	size_t clsBufferSize;
+	ImportBuffer learnedClausesToAdd;
+	UnitBuffer unitsToAdd;
+	vector<int> unitsBuffer;
+	PhaseBuffer phasesToSet;
+	vector<int> phasesBuffer;
+	AdapterStatistics adapterStats;
 
 public:
 
@@ -51,6 +54,8 @@ public:
 
 	// Get a variable suitable for search splitting
 	int getSplittingVariable();
+	// Get a splitting variable under the given assumptions, their variables have to be frozen
+	int getSplittingVariable(const vector<int>& assumptions);
 
 	// Set initial phase for a given variable
 	void setPhase(const int var, const bool phase);
@@ -61,6 +66,8 @@ public:
 
 	// Solve the formula with a given set of assumptions
 	SatResult solve(const vector<int>& assumptions);
+	void freezeVariable(int var);
+	vector<int> getSolution();
 
 	// Add a (list of) permanent clause(s) to the formula
 	void addClause(vector<int>& clause);
@@ -71,17 +78,20 @@ public:
 	// The learned clauses might be added later or possibly never
 	void addLearnedClause(vector<int>& clauses);
 	void addLearnedClauses(vector<vector<int> >& clauses);
+	void setPendingPhases(const vector<int>& phases);
 
 	// Set a function that should be called for each learned clause
 	void setLearnedClauseCallback(LearnedClauseCallback* callback, int solverId);
 
 	// Request the solver to produce more clauses
 	void increaseClauseProduction();
+	void reduceMemory();
 
 	// Get solver statistics
 	SolvingStatistics getStatistics();
 
 	void diversify(int rank, int size);
+	bool setOption(const char* name, int value);
 
 	Lingeling();
 	 ~Lingeling();
@@ -9,8 +9,11 @@
 #include "minisat/utils/System.h"
 #include "minisat/core/Dimacs.h"
 #include "../utilities/DebugUtils.h"
+#include "../utilities/Tracer.h"
 #include "MiniSat.h"
 #include "minisat/core/Solver.h"
+#include <string>
+#include <algorithm>
 
 using namespace Minisat;
 
@@ -23,9 +26,11 @@ using namespace Minisat;
 
 MiniSat::MiniSat() {
 	solver = new Solver();
-	learnedLimit = 0;
+	glueLimit = 0;
 	myId = 0;
 	callback = NULL;
+	unitsKnownBySolver = 0;
+	avoidedInterrupts = 0;
 }
 
 MiniSat::~MiniSat() {
@@ -64,6 +69,46 @@ void MiniSat::setSolverInterrupt() {
 // Diversify the solver
 void MiniSat::diversify(int rank, int size) {
 	solver->random_seed = (double)rank;
+	switch (rank % 8) {
+		case 0: default: break;
+		case 1: solver->luby_restart = false; break;
+		case 2: solver->restart_first = 50; break;
+		case 3: solver->var_decay = 0.9; break;
+		case 4: solver->phase_saving = 1; break;
+		case 5: solver->ccmin_mode = 1; break;
+		case 6: solver->rnd_init_act = true; break;
+		case 7: solver->random_var_freq = 0.02; break;
+	}
+}
+
+// Set one of the integer and boolean MiniSat options
+bool MiniSat::setOption(const char* name, int value) {
+	string opt(name);
+	if (opt == "seed") {
+		solver->random_seed = (double)value;
+	} else if (opt == "luby") {
+		solver->luby_restart = value != 0;
+	} else if (opt == "rfirst") {
+		solver->restart_first = value;
+	} else if (opt == "ccmin-mode") {
+		solver->ccmin_mode = value;
+	} else if (opt == "phase-saving") {
+		solver->phase_saving = value;
+	} else if (opt == "rnd-init") {
+		solver->rnd_init_act = value != 0;
+	} else if (opt == "var-decay") {
+		// in thousandths
+		solver->var_decay = value / 1000.0;
+	} else if (opt == "rinc") {
+		// in hundredths
+		solver->restart_inc = value / 100.0;
+	} else if (opt == "rnd-freq") {
+		// in thousandths
+		solver->random_var_freq = value / 1000.0;
+	} else {
+		return false;
+	}
+	return true;
 }
 
 void MiniSat::unsetSolverInterrupt() {
@@ -86,17 +131,9 @@ SatResult MiniSat::solve(const vector<int>& assumptions) {
 		}
 	}
 	clausesToAdd.clear();
-	for (size_t ind = 0; ind < learnedClausesToAdd.size(); ind++) {
-		vec<Lit> mlcls;
-		// skipping the first int containing the glue
-		for(size_t i = 1; i < learnedClausesToAdd[ind].size(); i++) {
-			mlcls.push(MINI_LIT(learnedClausesToAdd[ind][i]));
-		}
-		solver->addLearnedClause(mlcls);
-	}
-	learnedClausesToAdd.clear();
 	clauseAddingLock.unlock();
 
+	// the learned clauses and units are imported by miniImportCallback during the search
 	vec<Lit> miniAssumptions;
 	MAKE_MINI_VEC(assumptions, miniAssumptions);
 	lbool res = solver->solveLimited(miniAssumptions);
@@ -109,6 +146,10 @@ SatResult MiniSat::solve(const vector<int>& assumptions) {
 	return UNKNOWN;
 }
 
+// the core MiniSat solver does not eliminate variables
+void MiniSat::freezeVariable(int var) {
+}
+
 void MiniSat::addClause(vector<int>& clause) {
 	clauseAddingLock.lock();
 	clausesToAdd.push_back(clause);
@@ -116,16 +157,25 @@ void MiniSat::addClause(vector<int>& clause) {
 	setSolverInterrupt();
 }
 
+vector<int> MiniSat::getSolution() {
+	vector<int> result(1, 0);
+	for (int var = 1; var <= solver->model.size(); var++) {
+		result.push_back(solver->model[var-1] == l_True ? var : -var);
+	}
+	return result;
+}
+
+// Both the single clause and the batch version count one avoided interrupt
+// per call that used to interrupt the search
 void MiniSat::addLearnedClause(vector<int>& clause) {
-	clauseAddingLock.lock();
+	bool newUnit = false;
 	if (clause.size() == 1) {
-		clausesToAdd.push_back(clause);
+		newUnit = unitsToAdd.add(clause[0]);
 	} else {
-		learnedClausesToAdd.push_back(clause);
+		learnedClausesToAdd.add(clause);
 	}
-	clauseAddingLock.unlock();
-	if (learnedClausesToAdd.size() > CLS_COUNT_INTERRUPT_LIMIT) {
-		setSolverInterrupt();
+	if (learnedClausesToAdd.getPendingCount() > CLS_COUNT_INTERRUPT_LIMIT || newUnit) {
+		avoidedInterrupts++;
 	}
 }
 
@@ -154,47 +204,100 @@ void MiniSat::addInitialClauses(vector<vector<int> >& clauses) {
 }
 
 void MiniSat::addLearnedClauses(vector<vector<int> >& clauses) {
-	clauseAddingLock.lock();
+	bool newUnits = false;
 	for (size_t i = 0; i < clauses.size(); i++) {
-		if (clauses[i].size() == 1) {
-			clausesToAdd.push_back(clauses[i]);
-		} else {
-			learnedClausesToAdd.push_back(clauses[i]);
+		if (clauses[i].size() == 1 && unitsToAdd.add(clauses[i][0])) {
+			newUnits = true;
 		}
 	}
-	clauseAddingLock.unlock();
-	if (learnedClausesToAdd.size() > CLS_COUNT_INTERRUPT_LIMIT || clausesToAdd.size() > 0) {
-		setSolverInterrupt();
+	learnedClausesToAdd.add(clauses);
+	if (learnedClausesToAdd.getPendingCount() > CLS_COUNT_INTERRUPT_LIMIT || newUnits) {
+		// this used to interrupt the search, now the clauses wait for the next restart
+		avoidedInterrupts++;
 	}
 }
 
-void miniLearnCallback(const vec<Lit>& cls, void* issuer) {
+// taken by miniImportCallback at the next restart
+void MiniSat::setPendingPhases(const vector<int>& phases) {
+	phasesToSet.set(phases);
+}
+
+bool miniImportCallback(void* issuer) {
 	MiniSat* mp = (MiniSat*)issuer;
-	if (cls.size() > mp->learnedLimit) {
-		return;
+	TraceSpan span("import", &mp->adapterStats.importTime);
+	if (mp->phasesToSet.fetch(mp->phasesBuffer)) {
+		for (size_t i = 0; i < mp->phasesBuffer.size(); i++) {
+			int lit = mp->phasesBuffer[i];
+			mp->solver->setPolarity(abs(lit)-1, lit > 0 ? l_True : l_False);
+		}
+	}
+	size_t units = mp->unitsToAdd.fetch(mp->unitsBuffer);
+	for (size_t ind = 0; ind < units; ind++) {
+		Lit lit = MINI_LIT(mp->unitsBuffer[ind]);
+		// a false unit is added as well, the solver detects the conflict
+		if (mp->solver->value(lit) == l_True) {
+			mp->unitsKnownBySolver++;
+		} else if (!mp->solver->addClause(lit)) {
+			// unsat, the search will return l_False
+			return true;
+		}
 	}
-	vector<int> ncls;
-	if (cls.size() > 1) {
-		// fake glue value
-		int madeUpGlue = min(3, cls.size());
-		ncls.push_back(madeUpGlue);
+	size_t learned = 0;
+	int glue;
+	int* cls;
+	vec<Lit> mlcls;
+	while ((cls = mp->learnedClausesToAdd.next(&glue)) != NULL) {
+		mlcls.clear();
+		for (; *cls != 0; cls++) {
+			mlcls.push(MINI_LIT(*cls));
+		}
+		mp->solver->addLearnedClause(mlcls);
+		learned++;
+		if (!mp->solver->okay()) {
+			break;
+		}
 	}
+	mp->adapterStats.importedClauses += learned;
+	return units > 0 || learned > 0;
+}
+
+void miniLearnCallback(const vec<Lit>& cls, int lbd, void* issuer) {
+	MiniSat* mp = (MiniSat*)issuer;
+	if (cls.size() == 1) {
+		mp->adapterStats.learnedUnits++;
+		mp->unitsToAdd.markKnown(INT_LIT(cls[0]));
+	} else {
+		mp->adapterStats.learnedClauses++;
+		if (lbd > mp->glueLimit) {
+			return;
+		}
+	}
+	SampledTraceSpan span("export", &mp->adapterStats.exportTime);
+	vector<int>& ncls = mp->exportBuffer;
+	ncls.clear();
 	for (int i = 0; i < cls.size(); i++) {
 		ncls.push_back(INT_LIT(cls[i]));
 	}
-	mp->callback->processClause(ncls, mp->myId);
+	mp->callback->processClause(ncls.data(), ncls.size(), cls.size() > 1 ? lbd : 0, mp->myId);
 }
 
 void MiniSat::setLearnedClauseCallback(LearnedClauseCallback* callback, int solverId) {
 	this->callback = callback;
 	solver->learnedClsCallback = miniLearnCallback;
+	solver->importCallback = miniImportCallback;
 	solver->issuer = this;
-	learnedLimit = 3;
+	glueLimit = 2;
 	myId = solverId;
 }
 
 void MiniSat::increaseClauseProduction() {
-	learnedLimit++;
+	glueLimit++;
+}
+
+// The limit of learned clauses is computed from this factor when solving
+// starts, it does not go below a tenth of the default (1/3)
+void MiniSat::reduceMemory() {
+	solver->learntsize_factor = max(solver->learntsize_factor / 2, 1.0 / 30);
 }
 
 SolvingStatistics MiniSat::getStatistics() {
@@ -204,5 +307,13 @@ SolvingStatistics MiniSat::getStatistics() {
 	st.restarts = solver->starts;
 	st.decisions = solver->decisions;
 	st.memPeak = memUsedPeak();
+	st.memCurrent = memUsed();
+	st.importedUnits = unitsToAdd.getImportedCount() - unitsKnownBySolver;
+	st.knownUnits = unitsToAdd.getKnownCount() + unitsKnownBySolver;
+	st.avoidedInterrupts = avoidedInterrupts;
+	adapterStats.fill(st);
+	// the learned clauses not in the database any more were removed by reduceDB
+	unsigned long kept = solver->nLearnts();
+	st.deletedClauses = st.learnedClauses > kept ? st.learnedClauses - kept : 0;
 	return st;
 }
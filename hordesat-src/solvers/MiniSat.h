@@ -11,8 +11,12 @@
 
 #include "PortfolioSolverInterface.h"
 #include "../utilities/Threading.h"
+#include "../utilities/UnitBuffer.h"
+#include "../utilities/PhaseBuffer.h"
+#include "../utilities/ImportBuffer.h"
 using namespace std;
 
+// the queue length at which the learned clauses used to be imported by interrupting the solver
 #define CLS_COUNT_INTERRUPT_LIMIT 300
 
 // some forward declatarations for Minisat
@@ -27,13 +31,23 @@ class MiniSat : public PortfolioSolverInterface {
 
 private:
 	Minisat::Solver *solver;
-	vector< vector<int> > learnedClausesToAdd;
+	ImportBuffer learnedClausesToAdd;
 	vector< vector<int> > clausesToAdd;
+	UnitBuffer unitsToAdd;
+	vector<int> unitsBuffer;
+	PhaseBuffer phasesToSet;
+	vector<int> phasesBuffer;
+	// the literals of the learned clause given to the callback
+	vector<int> exportBuffer;
+	unsigned long unitsKnownBySolver;
+	unsigned long avoidedInterrupts;
+	AdapterStatistics adapterStats;
 	Mutex clauseAddingLock;
 	int myId;
 	LearnedClauseCallback* callback;
-	int learnedLimit;
-	friend void miniLearnCallback(const Minisat::vec<Minisat::Lit,int>& cls, void* issuer);
+	int glueLimit;
+	friend void miniLearnCallback(const Minisat::vec<Minisat::Lit,int>& cls, int lbd, void* issuer);
+	friend bool miniImportCallback(void* issuer);
 
 public:
 
@@ -51,6 +65,8 @@ public:
 	// Solve the formula with a given set of assumptions
 	// return 10 for SAT, 20 for UNSAT, 0 for UNKNOWN
 	SatResult solve(const vector<int>& assumptions);
+	void freezeVariable(int var);
+	vector<int> getSolution();
 
 	// Add a (list of) permanent clause(s) to the formula
 	void addClause(vector<int>& clause);
@@ -61,17 +77,20 @@ public:
 	// The learned clauses might be added later or possibly never
 	void addLearnedClause(vector<int>& clauses);
 	void addLearnedClauses(vector<vector<int> >& clauses);
+	void setPendingPhases(const vector<int>& phases);
 
 	// Set a function that should be called for each learned clause
 	void setLearnedClauseCallback(LearnedClauseCallback* callback, int solverId);
 
 	// Request the solver to produce more clauses
 	void increaseClauseProduction();
+	void reduceMemory();
 
 	// Get solver statistics
 	SolvingStatistics getStatistics();
 	// Diversify
 	void diversify(int rank, int size);
+	bool setOption(const char* name, int value);
 
 	// constructor
 	MiniSat();
@@ -19,17 +19,62 @@ enum SatResult {
 };
 
 struct SolvingStatistics {
-	SolvingStatistics():propagations(0),decisions(0),conflicts(0),restarts(0),memPeak(0) {}
+	SolvingStatistics():propagations(0),decisions(0),conflicts(0),restarts(0),memPeak(0),
+			importedUnits(0),knownUnits(0),avoidedInterrupts(0),learnedClauses(0),deletedClauses(0),
+			importedClauses(0),fixedUnits(0),memCurrent(0),importTime(0),exportTime(0) {}
 	unsigned long propagations;
 	unsigned long decisions;
 	unsigned long conflicts;
 	unsigned long restarts;
 	double memPeak;
+	// shared units given to the solver and units it already knew
+	unsigned long importedUnits;
+	unsigned long knownUnits;
+	// imports done without interrupting the search
+	unsigned long avoidedInterrupts;
+	// learned clauses reported by the solver and the ones it deleted
+	unsigned long learnedClauses;
+	unsigned long deletedClauses;
+	// shared non-unit clauses the solver actually took in
+	unsigned long importedClauses;
+	// learned and imported units
+	unsigned long fixedUnits;
+	double memCurrent;
+	// seconds spent in the clause import and export callbacks, estimated
+	// from samples for the callbacks called for each clause
+	double importTime;
+	double exportTime;
+};
+
+// The statistics measured by the adapters, the solvers do not count them
+// or have no API for them
+struct AdapterStatistics {
+	AdapterStatistics():learnedClauses(0),learnedUnits(0),importedClauses(0),importTime(0),exportTime(0) {}
+	unsigned long learnedClauses;
+	unsigned long learnedUnits;
+	unsigned long importedClauses;
+	double importTime;
+	double exportTime;
+	// call after st.importedUnits is set
+	void fill(SolvingStatistics& st) const {
+		st.learnedClauses = learnedClauses;
+		st.importedClauses = importedClauses;
+		st.fixedUnits = learnedUnits + st.importedUnits;
+		st.importTime = importTime;
+		st.exportTime = exportTime;
+	}
 };
 
 class LearnedClauseCallback {
 public:
-	virtual void processClause(vector<int>& cls, int solverId) = 0;
+	/**
+	 * Called by the solver thread for each exported learned clause. The
+	 * literals are only valid during the call, the glue of units is 0.
+	 * Adapters of solvers that do not compute the LBD (CaDiCaL) pass the
+	 * clause size as its upper bound, so their clauses are ranked by size
+	 * and only their binary clauses are sent as VIP clauses.
+	 */
+	virtual void processClause(const int* lits, size_t len, int glue, int solverId) = 0;
 	virtual ~LearnedClauseCallback() {};
 };
 
@@ -59,6 +104,12 @@ public:
 	// Solve the formula with a given set of assumptions
 	virtual SatResult solve(const vector<int>& assumptions = vector<int>()) = 0;
 
+	// Keep the variable in the formula (no elimination), so it can be used in later assumptions
+	virtual void freezeVariable(int var) = 0;
+
+	// Get the model after SAT was returned, result[var] is var or -var (result[0] is unused)
+	virtual vector<int> getSolution() = 0;
+
 	// Add a (list of) permanent clause(s) to the formula
 	virtual void addClause(vector<int>& clause) = 0;
 	virtual void addClauses(vector<vector<int> >& clauses) = 0;
@@ -69,17 +120,32 @@ public:
 	virtual void addLearnedClause(vector<int>& clauses) = 0;
 	virtual void addLearnedClauses(vector<vector<int> >& clauses) = 0;
 
+	// Called after each sharing round, interrupt the solver if an import
+	// was postponed by the rate limit and the limit has passed
+	virtual void retryImport() {}
+
+	// Set phases (signed literals) from another thread while the solver runs.
+	// The solvers that import clauses during the search take them at their
+	// next import point, the others get their phases by setPhase before a solve call.
+	virtual void setPendingPhases(const vector<int>& phases) {}
+
 	// Set a function that should be called for each learned clause
 	virtual void setLearnedClauseCallback(LearnedClauseCallback* callback, int solverId) = 0;
 
 	// Request the solver to produce more clauses
 	virtual void increaseClauseProduction() = 0;
 
+	// Make the learned clause database smaller, called by the solver thread between two solve calls
+	virtual void reduceMemory() = 0;
+
 	// Get solver statistics
 	virtual SolvingStatistics getStatistics() = 0;
 
 	virtual void diversify(int rank, int size) = 0;
 
+	// Set a solver specific option before solving, return false if the option is not supported
+	virtual bool setOption(const char* name, int value) = 0;
+
 	// destructor
 	virtual ~PortfolioSolverInterface() {}
 };
@@ -0,0 +1,366 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * ProbSat.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#include "ProbSat.h"
+#include "../utilities/SatUtils.h"
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+
+ProbSat::ProbSat(int seed) {
+	stopSolver = 0;
+	initialized = false;
+	numVars = 0;
+	cb = 2.5;
+	setOption("seed", seed);
+	flips = 0;
+	lastSaveFlips = 0;
+	bestUnsat = -1;
+	bestExported = true;
+}
+
+ProbSat::~ProbSat() {
+}
+
+// xorshift64, much faster than rand() and thread safe
+unsigned int ProbSat::nextRandom() {
+	randState ^= randState << 13;
+	randState ^= randState >> 7;
+	randState ^= randState << 17;
+	return (unsigned int)(randState >> 32);
+}
+
+bool ProbSat::loadFormula(const char* filename) {
+	vector<PortfolioSolverInterface*> solvers;
+	solvers.push_back(this);
+	return loadFormulaToSolvers(solvers, filename);
+}
+
+int ProbSat::getVariablesCount() {
+	return numVars;
+}
+
+int ProbSat::getSplittingVariable() {
+	return 0;
+}
+
+void ProbSat::setPhase(const int var, const bool phase) {
+	if ((int)assignment.size() <= var) {
+		assignment.resize(var+1, PROBSAT_UNSET);
+	}
+	assignment[var] = phase;
+}
+
+void ProbSat::setSolverInterrupt() {
+	stopSolver = 1;
+}
+
+void ProbSat::unsetSolverInterrupt() {
+	stopSolver = 0;
+}
+
+void ProbSat::addClause(vector<int>& clause) {
+	clauseList.push_back(clause);
+	initialized = false;
+}
+
+void ProbSat::addClauses(vector<vector<int> >& clauses) {
+	clauseList.insert(clauseList.end(), clauses.begin(), clauses.end());
+	initialized = false;
+}
+
+void ProbSat::addInitialClauses(vector<vector<int> >& clauses) {
+	clauseList.insert(clauseList.end(), clauses.begin(), clauses.end());
+	for (size_t i = 0; i < clauses.size(); i++) {
+		for (size_t j = 0; j < clauses[i].size(); j++) {
+			numVars = max(numVars, abs(clauses[i][j]));
+		}
+	}
+	initialized = false;
+}
+
+void ProbSat::addLearnedClause(vector<int>& clause) {
+	if (clause.size() == 1) {
+		unitsToAdd.add(clause[0]);
+	}
+}
+
+void ProbSat::addLearnedClauses(vector<vector<int> >& clauses) {
+	for (size_t i = 0; i < clauses.size(); i++) {
+		if (clauses[i].size() == 1) {
+			unitsToAdd.add(clauses[i][0]);
+		}
+	}
+}
+
+void ProbSat::setLearnedClauseCallback(LearnedClauseCallback* callback, int solverId) {
+}
+
+void ProbSat::increaseClauseProduction() {
+}
+
+// local search keeps no learned clauses
+void ProbSat::reduceMemory() {
+}
+
+// Build the flat clause and occurrence arrays, tautologies are removed
+// and the variables of unit clauses are fixed.
+void ProbSat::initialize() {
+	for (size_t i = 0; i < clauseList.size(); i++) {
+		for (size_t j = 0; j < clauseList[i].size(); j++) {
+			numVars = max(numVars, abs(clauseList[i][j]));
+		}
+	}
+	assignment.resize(numVars+1, PROBSAT_UNSET);
+	for (int var = 1; var <= numVars; var++) {
+		if (assignment[var] == PROBSAT_UNSET) {
+			assignment[var] = nextRandom() % 2;
+		}
+	}
+	fixed.resize(numVars+1, 0);
+	clauseStart.clear();
+	literals.clear();
+	vector<int> occCount(2*numVars+2, 0);
+	vector<int> cls;
+	for (size_t i = 0; i < clauseList.size(); i++) {
+		cls = clauseList[i];
+		sort(cls.begin(), cls.end());
+		cls.erase(unique(cls.begin(), cls.end()), cls.end());
+		bool tautology = false;
+		for (size_t j = 1; j < cls.size(); j++) {
+			if (cls[j] == -cls[j-1] || binary_search(cls.begin(), cls.end(), -cls[j])) {
+				tautology = true;
+				break;
+			}
+		}
+		if (tautology || cls.empty()) {
+			continue;
+		}
+		if (cls.size() == 1) {
+			fixed[abs(cls[0])] = 1;
+			assignment[abs(cls[0])] = cls[0] > 0;
+		}
+		clauseStart.push_back(literals.size());
+		for (size_t j = 0; j < cls.size(); j++) {
+			literals.push_back(cls[j]);
+			occCount[litIndex(cls[j])]++;
+		}
+	}
+	int numClauses = clauseStart.size();
+	clauseStart.push_back(literals.size());
+
+	occStart.assign(2*numVars+3, 0);
+	for (int l = 0; l < 2*numVars+2; l++) {
+		occStart[l+1] = occStart[l] + occCount[l];
+	}
+	occurrences.resize(literals.size());
+	vector<int> pos(occStart.begin(), occStart.end()-1);
+	for (int c = 0; c < numClauses; c++) {
+		for (int i = clauseStart[c]; i < clauseStart[c+1]; i++) {
+			occurrences[pos[litIndex(literals[i])]++] = c;
+		}
+	}
+
+	// polynomial break function of probSAT
+	for (int b = 0; b <= PROBSAT_MAX_BREAK; b++) {
+		probs[b] = pow(1.0 + b, -cb);
+	}
+	initializeState();
+	initialized = true;
+}
+
+void ProbSat::initializeState() {
+	int numClauses = clauseStart.size() - 1;
+	numTrue.assign(numClauses, 0);
+	critXor.assign(numClauses, 0);
+	breaks.assign(numVars+1, 0);
+	whereUnsat.assign(numClauses, -1);
+	unsatClauses.clear();
+	for (int c = 0; c < numClauses; c++) {
+		for (int i = clauseStart[c]; i < clauseStart[c+1]; i++) {
+			if (isTrue(literals[i])) {
+				numTrue[c]++;
+				critXor[c] ^= abs(literals[i]);
+			}
+		}
+		if (numTrue[c] == 0) {
+			whereUnsat[c] = unsatClauses.size();
+			unsatClauses.push_back(c);
+		} else if (numTrue[c] == 1) {
+			breaks[critXor[c]]++;
+		}
+	}
+}
+
+void ProbSat::flip(int var) {
+	assignment[var] = !assignment[var];
+	int trueLit = assignment[var] ? var : -var;
+	flips++;
+
+	// clauses that gained a true literal
+	for (int i = occStart[litIndex(trueLit)]; i < occStart[litIndex(trueLit)+1]; i++) {
+		int c = occurrences[i];
+		numTrue[c]++;
+		if (numTrue[c] == 1) {
+			int last = unsatClauses.back();
+			unsatClauses[whereUnsat[c]] = last;
+			whereUnsat[last] = whereUnsat[c];
+			unsatClauses.pop_back();
+			whereUnsat[c] = -1;
+			breaks[var]++;
+		} else if (numTrue[c] == 2) {
+			breaks[critXor[c]]--;
+		}
+		critXor[c] ^= var;
+	}
+	// clauses that lost a true literal
+	for (int i = occStart[litIndex(-trueLit)]; i < occStart[litIndex(-trueLit)+1]; i++) {
+		int c = occurrences[i];
+		numTrue[c]--;
+		critXor[c] ^= var;
+		if (numTrue[c] == 0) {
+			whereUnsat[c] = unsatClauses.size();
+			unsatClauses.push_back(c);
+			breaks[var]--;
+		} else if (numTrue[c] == 1) {
+			breaks[critXor[c]]++;
+		}
+	}
+}
+
+void ProbSat::importUnits() {
+	size_t units = unitsToAdd.fetch(unitsBuffer);
+	for (size_t i = 0; i < units; i++) {
+		int lit = unitsBuffer[i];
+		int var = abs(lit);
+		if (var > numVars || fixed[var]) {
+			continue;
+		}
+		if (!isTrue(lit)) {
+			flip(var);
+		}
+		fixed[var] = 1;
+	}
+}
+
+void ProbSat::saveBest() {
+	lastSaveFlips = flips;
+	bestLock.lock();
+	bestAssignment = assignment;
+	bestUnsat = unsatClauses.size();
+	bestExported = false;
+	bestLock.unlock();
+}
+
+bool ProbSat::getBestAssignment(vector<int>& phases, int& unsat) {
+	bestLock.lock();
+	if (bestExported) {
+		bestLock.unlock();
+		return false;
+	}
+	phases.clear();
+	for (int var = 1; var < (int)bestAssignment.size(); var++) {
+		phases.push_back(bestAssignment[var] ? var : -var);
+	}
+	unsat = bestUnsat;
+	bestExported = true;
+	bestLock.unlock();
+	return true;
+}
+
+// Continue the search from the current assignment until it is
+// satisfied or the search is interrupted
+SatResult ProbSat::solve(const vector<int>& assumptions) {
+	if (!assumptions.empty()) {
+		return UNKNOWN;
+	}
+	if (!initialized) {
+		initialize();
+	}
+	vector<double> weights;
+	int bestSeen = bestUnsat < 0 ? unsatClauses.size() + 1 : bestUnsat;
+	while (!stopSolver) {
+		importUnits();
+		for (int step = 0; step < PROBSAT_CHECK_INTERVAL; step++) {
+			if (unsatClauses.empty()) {
+				saveBest();
+				return SAT;
+			}
+			// copying the assignment costs at most one step per flip
+			if ((int)unsatClauses.size() < bestSeen && flips - lastSaveFlips >= (unsigned long)numVars) {
+				bestSeen = unsatClauses.size();
+				saveBest();
+			}
+			int c = unsatClauses[nextRandom() % unsatClauses.size()];
+			int begin = clauseStart[c];
+			int size = clauseStart[c+1] - begin;
+			weights.resize(size);
+			double sum = 0;
+			for (int i = 0; i < size; i++) {
+				int var = abs(literals[begin+i]);
+				weights[i] = fixed[var] ? 0 : probs[min(breaks[var], PROBSAT_MAX_BREAK)];
+				sum += weights[i];
+			}
+			// all the variables are fixed, another clause will be picked
+			if (sum == 0) {
+				continue;
+			}
+			double r = sum * (nextRandom() / 4294967296.0);
+			int pick = 0;
+			while (pick < size-1 && r >= weights[pick]) {
+				r -= weights[pick];
+				pick++;
+			}
+			while (weights[pick] == 0) {
+				pick--;
+			}
+			flip(abs(literals[begin+pick]));
+		}
+	}
+	return UNKNOWN;
+}
+
+void ProbSat::freezeVariable(int var) {
+}
+
+SolvingStatistics ProbSat::getStatistics() {
+	SolvingStatistics st;
+	// a flip is the local search counterpart of a decision
+	st.decisions = flips;
+	st.importedUnits = unitsToAdd.getImportedCount();
+	st.knownUnits = unitsToAdd.getKnownCount();
+	return st;
+}
+
+vector<int> ProbSat::getSolution() {
+	vector<int> result(1, 0);
+	for (int var = 1; var <= numVars; var++) {
+		result.push_back(assignment[var] ? var : -var);
+	}
+	return result;
+}
+
+void ProbSat::diversify(int rank, int size) {
+	randState = 88172645463325252ULL + 2654435761ULL * (rank + 1);
+	cb = 2.0 + 0.1 * (rank % 10);
+	initialized = false;
+}
+
+// cb is given in hundredths
+bool ProbSat::setOption(const char* name, int value) {
+	if (strcmp(name, "seed") == 0) {
+		randState = 88172645463325252ULL + 2654435761ULL * (value + 1);
+	} else if (strcmp(name, "cb") == 0) {
+		cb = value / 100.0;
+		initialized = false;
+	} else {
+		return false;
+	}
+	return true;
+}
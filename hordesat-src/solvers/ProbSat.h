@@ -0,0 +1,134 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * ProbSat.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#ifndef PROBSAT_H_
+#define PROBSAT_H_
+
+#include "PortfolioSolverInterface.h"
+#include "../utilities/Threading.h"
+#include "../utilities/UnitBuffer.h"
+
+// break values above this share the same (tiny) probability
+#define PROBSAT_MAX_BREAK 64
+// how many flips are done between checking the interrupt flag and the units
+#define PROBSAT_CHECK_INTERVAL 4096
+// value of the variables without an initial phase
+#define PROBSAT_UNSET 2
+
+/**
+ * Stochastic local search in the style of probSAT (polynomial break function).
+ * It can only find satisfying assignments. The best assignment found so far
+ * is offered to the CDCL solvers as phases and shared units are imported
+ * as fixed variables.
+ */
+class ProbSat : public PortfolioSolverInterface {
+
+private:
+	volatile int stopSolver;
+	bool initialized;
+	int numVars;
+	// clauses and the occurrence lists in compressed row format,
+	// the occurrences of a literal are at occStart[litIndex(lit)]
+	vector<vector<int> > clauseList;
+	vector<int> clauseStart;
+	vector<int> literals;
+	vector<int> occStart;
+	vector<int> occurrences;
+
+	// search state
+	vector<char> assignment;
+	vector<char> fixed;
+	vector<int> numTrue;
+	// xor of the variables of the true literals, the critical variable if numTrue is 1
+	vector<int> critXor;
+	vector<int> breaks;
+	vector<int> unsatClauses;
+	vector<int> whereUnsat;
+	double probs[PROBSAT_MAX_BREAK+1];
+	double cb;
+	unsigned long long randState;
+	unsigned long flips;
+	unsigned long lastSaveFlips;
+
+	// the best assignment, read by the main thread
+	Mutex bestLock;
+	vector<char> bestAssignment;
+	int bestUnsat;
+	bool bestExported;
+
+	UnitBuffer unitsToAdd;
+	vector<int> unitsBuffer;
+
+	int litIndex(int lit) {
+		return 2*abs(lit) + (lit < 0);
+	}
+	bool isTrue(int lit) {
+		return assignment[abs(lit)] == (lit > 0);
+	}
+	unsigned int nextRandom();
+	void initialize();
+	void initializeState();
+	void importUnits();
+	void flip(int var);
+	void saveBest();
+
+public:
+
+	// Load formula from a given dimacs file, return false if failed
+	bool loadFormula(const char* filename);
+
+	// Get the number of variables of the formula
+	int getVariablesCount();
+
+	// Get a variable suitable for search splitting
+	int getSplittingVariable();
+
+	// Set initial phase for a given variable
+	void setPhase(const int var, const bool phase);
+
+	// Interrupt the SAT solving
+	void setSolverInterrupt();
+	void unsetSolverInterrupt();
+
+	// Search for a satisfying assignment, assumptions are not supported
+	SatResult solve(const vector<int>& assumptions);
+	void freezeVariable(int var);
+	vector<int> getSolution();
+
+	// Add a (list of) permanent clause(s) to the formula
+	void addClause(vector<int>& clause);
+	void addClauses(vector<vector<int> >& clauses);
+	void addInitialClauses(vector<vector<int> >& clauses);
+
+	// Only the units of the learned clauses are used
+	void addLearnedClause(vector<int>& clauses);
+	void addLearnedClauses(vector<vector<int> >& clauses);
+
+	// Local search does not learn clauses
+	void setLearnedClauseCallback(LearnedClauseCallback* callback, int solverId);
+	void increaseClauseProduction();
+	void reduceMemory();
+
+	// Get solver statistics
+	SolvingStatistics getStatistics();
+
+	void diversify(int rank, int size);
+	bool setOption(const char* name, int value);
+
+	/**
+	 * If the best assignment improved since the last call, store it
+	 * as literals into phases and its number of unsatisfied clauses
+	 * into unsat and return true.
+	 */
+	bool getBestAssignment(vector<int>& phases, int& unsat);
+
+	ProbSat(int seed);
+	~ProbSat();
+};
+
+#endif /* PROBSAT_H_ */
@@ -0,0 +1,127 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * AdaptivePortfolio.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#include "AdaptivePortfolio.h"
+#include "Diversification.h"
+#include "Logger.h"
+#include <stdio.h>
+
+static string describe(const vector<pair<string, int> >& options) {
+	string text;
+	for (size_t i = 0; i < options.size(); i++) {
+		char buffer[128];
+		snprintf(buffer, sizeof(buffer), " %s=%d", options[i].first.c_str(), options[i].second);
+		text += buffer;
+	}
+	return text.empty() ? " defaults" : text;
+}
+
+AdaptivePortfolio::AdaptivePortfolio(vector<PortfolioSolverInterface*>& solvers, const vector<string>& names,
+		const vector<vector<pair<string, int> > >& options, SharingManagerInterface* sharing,
+		double interval, int seed)
+	:solvers(solvers),names(names),options(options),sharing(sharing),interval(interval),seed(seed),
+	 lastTime(0),generation(0),reconfigurations(0) {
+	pending.resize(solvers.size());
+	hasPending.resize(solvers.size(), false);
+	lastSolving.resize(solvers.size());
+	lastExport.resize(solvers.size());
+	for (size_t sid = 0; sid < solvers.size(); sid++) {
+		adaptable.push_back(names[sid] == "lingeling" || names[sid] == "minisat");
+	}
+}
+
+double AdaptivePortfolio::score(int sid, double elapsed) {
+	SolvingStatistics st = solvers[sid]->getStatistics();
+	double conflicts = st.conflicts - lastSolving[sid].conflicts;
+	lastSolving[sid] = st;
+	double exportScore = 0;
+	if (sharing != NULL) {
+		SolverExportStatistics ex = sharing->getSolverStatistics(sid);
+		double exported = ex.exportedClauses - lastExport[sid].exportedClauses;
+		if (exported > 0) {
+			double avgGlue = (ex.glueSum - lastExport[sid].glueSum) / exported;
+			exportScore = ADAPT_EXPORT_WEIGHT * exported / (1 + avgGlue);
+		}
+		lastExport[sid] = ex;
+	}
+	return (conflicts + exportScore) / elapsed;
+}
+
+void AdaptivePortfolio::adapt(double time) {
+	if (time - lastTime < interval) {
+		return;
+	}
+	double elapsed = time - lastTime;
+	lastTime = time;
+	vector<double> scores(solvers.size());
+	for (size_t sid = 0; sid < solvers.size(); sid++) {
+		if (solvers[sid] != NULL) {
+			scores[sid] = score(sid, elapsed);
+		}
+	}
+	generation++;
+	vector<bool> done(solvers.size(), false);
+	for (size_t first = 0; first < solvers.size(); first++) {
+		if (done[first]) {
+			continue;
+		}
+		int best = -1, worst = -1;
+		lock.lock();
+		for (size_t sid = first; sid < solvers.size(); sid++) {
+			if (names[sid] != names[first]) {
+				continue;
+			}
+			done[sid] = true;
+			// the options given in the last generation were not used long enough
+			if (!adaptable[sid] || hasPending[sid] || solvers[sid] == NULL) {
+				continue;
+			}
+			if (best == -1 || scores[sid] > scores[best]) {
+				best = sid;
+			}
+			if (worst == -1 || scores[sid] < scores[worst]) {
+				worst = sid;
+			}
+		}
+		if (best == worst || scores[best] <= 0 || scores[worst] >= ADAPT_MIN_RATIO * scores[best]) {
+			lock.unlock();
+			continue;
+		}
+		options[worst] = mutateOptions(names[best], options[best], seed * 1000003ULL + generation * 101ULL + worst);
+		pending[worst] = options[worst];
+		hasPending[worst] = true;
+		lock.unlock();
+		solvers[worst]->setSolverInterrupt();
+		reconfigurations++;
+		log(1, "adapt generation %d: %s %d (score %.1f) takes the options of %d (score %.1f) mutated:%s\n",
+				generation, names[worst].c_str(), worst, scores[worst], best, scores[best],
+				describe(options[worst]).c_str());
+	}
+}
+
+void AdaptivePortfolio::applyPending(int sid) {
+	lock.lock();
+	if (!hasPending[sid]) {
+		lock.unlock();
+		return;
+	}
+	vector<pair<string, int> > newOptions;
+	newOptions.swap(pending[sid]);
+	hasPending[sid] = false;
+	lock.unlock();
+	for (size_t i = 0; i < newOptions.size(); i++) {
+		if (!solvers[sid]->setOption(newOptions[i].first.c_str(), newOptions[i].second)) {
+			log(1, "adapt: %s %d does not accept option %s while solving, not adapting it any more\n",
+					names[sid].c_str(), sid, newOptions[i].first.c_str());
+			lock.lock();
+			adaptable[sid] = false;
+			lock.unlock();
+			return;
+		}
+	}
+}
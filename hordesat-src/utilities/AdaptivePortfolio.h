@@ -0,0 +1,81 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * AdaptivePortfolio.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#ifndef ADAPTIVEPORTFOLIO_H_
+#define ADAPTIVEPORTFOLIO_H_
+
+#include <string>
+#include <vector>
+#include "Threading.h"
+#include "../solvers/PortfolioSolverInterface.h"
+#include "../sharing/SharingManagerInterface.h"
+
+using namespace std;
+
+// an exported clause with glue 0 is worth this many conflicts in the score
+#define ADAPT_EXPORT_WEIGHT 10.0
+// the worst solver is reconfigured if its score is below this part of the best
+#define ADAPT_MIN_RATIO 0.5
+
+/**
+ * Online tuning of the solver options of a node. Every interval the solvers
+ * are scored by their conflicts per second and by the number and quality
+ * (glue) of the clauses they exported since the last evaluation. Among the
+ * solvers of the same kind, the worst one gets the options of the best one
+ * with one option mutated. It is interrupted and continues with the new
+ * options, its learned clauses are kept. Options the worst solver had but
+ * the best one does not are not reset, the solvers have no way to do it.
+ * Only the solvers which accept options while solving take part
+ * (lingeling and minisat).
+ */
+class AdaptivePortfolio {
+public:
+	/**
+	 * The names are the solver kinds as in sampleOptions, options are
+	 * the options applied by the diversification.
+	 */
+	AdaptivePortfolio(vector<PortfolioSolverInterface*>& solvers, const vector<string>& names,
+			const vector<vector<pair<string, int> > >& options, SharingManagerInterface* sharing,
+			double interval, int seed);
+	/**
+	 * Evaluate the solvers if the interval passed. Called by the main thread.
+	 */
+	void adapt(double time);
+	/**
+	 * Apply the waiting new options of the solver, called by the solver
+	 * thread before it starts solving.
+	 */
+	void applyPending(int sid);
+	int getReconfigurations() {
+		return reconfigurations;
+	}
+
+private:
+	// the solvers released by the memory governor are NULL
+	vector<PortfolioSolverInterface*>& solvers;
+	vector<string> names;
+	vector<vector<pair<string, int> > > options;
+	SharingManagerInterface* sharing;
+	double interval;
+	unsigned long long seed;
+
+	Mutex lock;
+	vector<vector<pair<string, int> > > pending;
+	vector<bool> hasPending;
+	vector<bool> adaptable;
+
+	vector<SolvingStatistics> lastSolving;
+	vector<SolverExportStatistics> lastExport;
+	double lastTime;
+	int generation;
+	int reconfigurations;
+
+	double score(int sid, double elapsed);
+};
+
+#endif /* ADAPTIVEPORTFOLIO_H_ */
@@ -13,18 +13,65 @@
 #include "Logger.h"
 
 
+// The vector already contains the glue, the literals get it in front (if not 0)
 void ClauseDatabase::addVIPClause(vector<int>& clause) {
+	storeVIPClause(0, clause.data(), clause.size(), (size_t)-1);
+}
+
+bool ClauseDatabase::addVIPClause(const int* lits, size_t len, int glue, size_t limit) {
+	if (len == 1) {
+		return storeVIPClause(0, lits, len, (size_t)-1);
+	}
+	return storeVIPClause(1 + glue, lits, len, limit);
+}
+
+bool ClauseDatabase::storeVIPClause(int head, const int* lits, size_t len, size_t limit) {
+	addClauseLock.lock();
+	if (vipClauses.size() >= limit) {
+		addClauseLock.unlock();
+		return false;
+	}
+	if (head != 0) {
+		vipClauses.push_back(head);
+	}
+	vipClauses.insert(vipClauses.end(), lits, lits + len);
+	vipClauses.push_back(0);
+	vipCount++;
+	addClauseLock.unlock();
+	return true;
+}
+
+size_t ClauseDatabase::getVIPSize() {
+	addClauseLock.lock();
+	size_t result = vipClauses.size();
+	addClauseLock.unlock();
+	return result;
+}
+
+int ClauseDatabase::giveVIPSelection(vector<int>& buffer) {
 	addClauseLock.lock();
-	vipClauses.push_back(clause);
+	int count = vipCount;
+	buffer.insert(buffer.end(), vipClauses.begin(), vipClauses.end());
+	vipClauses.clear();
+	vipCount = 0;
 	addClauseLock.unlock();
+	return count;
 }
 
 int* ClauseDatabase::addClause(vector<int>& clause) {
+	return storeClause(0, clause.data(), clause.size());
+}
+
+int* ClauseDatabase::addClause(const int* lits, size_t len, int glue) {
+	return storeClause(len > 1 ? 1 + glue : 0, lits, len);
+}
+
+int* ClauseDatabase::storeClause(int head, const int* lits, size_t len) {
 	if (addClauseLock.tryLock() == false) {
 		return NULL;
 	}
 
-	unsigned int csize = clause.size();
+	unsigned int csize = head != 0 ? len + 1 : len;
 
 	while (buckets.size() < csize) {
 		Bucket* b = new Bucket();
@@ -34,8 +81,12 @@ int* ClauseDatabase::addClause(vector<int>& clause) {
 	unsigned int top = b->top;
 	if (top + csize < BUCKET_SIZE) {
 		// copy the clause
-		for (unsigned int i = 0; i < csize; i++) {
-			b->data[top + i] = clause[i];
+		int* data = b->data + top;
+		if (head != 0) {
+			*data++ = head;
+		}
+		for (size_t i = 0; i < len; i++) {
+			data[i] = lits[i];
 		}
 		// update top
 		b->top += csize;
@@ -49,10 +100,10 @@ int* ClauseDatabase::addClause(vector<int>& clause) {
 
 /**
  * Format of the data in the buffer:
- * pos 0: the total length of all VIP clauses (with separators)
- * pos 1 .. k: the VIP clause literals separated by zeros
- * pos k+1: the number of unary clauses
- * pos k+2 .. l: the literals of unary clauses (without separators)
+ * pos 0: the total length of the VIP clauses, always 0 since they are
+ *        exchanged separately (see giveVIPSelection)
+ * pos 1: the number of unary clauses
+ * pos 2 .. l: the literals of unary clauses (without separators)
  * pos l+1: the number of binary clauses
  * pos l+2 .. m: the literals of binary clauses (without separators)
  * ...
@@ -64,25 +115,8 @@ unsigned int ClauseDatabase::giveSelection(int* buffer, unsigned int size, int*
 	// clear the buffer
 	memset(buffer, 0, sizeof(int)*size);
 	unsigned int used = 0;
-	// The first value is the total length of VIP clauses (with separators)
-	used++
-	// First add the VIP clauses
-	DEBUG(printf("adding the %d VIP clauses.\n", vipClauses.size()));
-	while (!vipClauses.empty()) {
-		vector<int>& vipCls = vipClauses.back();
-		int len = vipCls.size();
-		for (int i = 0; i < len; i++) {
-			buffer[used++] = vipCls[i];
-		}
-		buffer[used++] = 0;
-		vipClauses.pop_back();
-	}
-	buffer[0] = used-1;
-
-	if (used >= size) {
-		printf("ERROR: vip clauses exceeded the buffer size.");
-		exit(99);
-	}
+	// The first value is the total length of VIP clauses, they are not here
+	buffer[used++] = 0;
 
 	int fitting = 0;
 	int notFitting = 0;
@@ -129,8 +163,6 @@ void ClauseDatabase::setIncomingBuffer(const int* buffer, int size, int nodes, i
 	this->size = size;
 	this->nodes = nodes;
 	this->thisNode = thisNode;
-	lastVipClsIndex = 1;
-	lastVipNode = 0;
 
 	lastClsNode = 0;
 	lastClsSize = 1;
@@ -173,21 +205,19 @@ bool ClauseDatabase::getNextIncomingClause(vector<int>& cls) {
 	}
 }
 
+void ClauseDatabase::setIncomingVIPBuffer(const int* buffer, int size) {
+	incommingVipBuffer = buffer;
+	vipSize = size;
+	lastVipClsIndex = 0;
+}
+
 bool ClauseDatabase::getNextIncomingVIPClause(vector<int>& cls) {
-	unsigned int offset = lastVipNode*size;
-	unsigned int vipsHere = incommingBuffer[offset];
-	while (lastVipClsIndex > vipsHere) {
-		lastVipNode++;
-		offset = lastVipNode*size;
-		vipsHere = incommingBuffer[offset];
-		lastVipClsIndex = 1;
-		if (lastVipNode >= nodes) {
-			return false;
-		}
+	if (lastVipClsIndex >= vipSize) {
+		return false;
 	}
 	cls.clear();
-	while (incommingBuffer[offset + lastVipClsIndex] != 0) {
-		cls.push_back(incommingBuffer[offset + lastVipClsIndex]);
+	while (incommingVipBuffer[lastVipClsIndex] != 0) {
+		cls.push_back(incommingVipBuffer[lastVipClsIndex]);
 		lastVipClsIndex++;
 	}
 	lastVipClsIndex++;
@@ -23,6 +23,8 @@ struct Bucket {
 
 class ClauseDatabase {
 public:
+	ClauseDatabase():vipCount(0) {
+	}
 	virtual ~ClauseDatabase();
 
 	/**
@@ -30,9 +32,30 @@ public:
 	 */
 	int* addClause(vector<int>& clause);
 	/**
-	 * Add a very important learned clause that you want to share
+	 * The same for a clause given by its literals and glue, the glue is
+	 * stored as the first int (1+glue) of non-unit clauses.
+	 */
+	int* addClause(const int* lits, size_t len, int glue);
+	/**
+	 * Add a very important learned clause that you want to share, it is never
+	 * dropped and is sent by giveVIPSelection instead of giveSelection.
 	 */
 	void addVIPClause(vector<int>& clause);
+	/**
+	 * The same for a clause given by its literals and glue, it is only
+	 * stored if the VIP clauses use less than limit ints (units are always
+	 * stored). Return false if it was not stored.
+	 */
+	bool addVIPClause(const int* lits, size_t len, int glue, size_t limit);
+	/**
+	 * The number of ints the VIP clauses would take in giveVIPSelection.
+	 */
+	size_t getVIPSize();
+	/**
+	 * Append all the VIP clauses separated by zeros to the buffer.
+	 * Return the number of VIP clauses.
+	 */
+	int giveVIPSelection(vector<int>& buffer);
 	/**
 	 * Fill the given buffer with data for the sending our learned clauses
 	 * Return the number of used memory, at most size.
@@ -44,6 +67,11 @@ public:
 	 * nodes. Each part has "size" integers.
 	 */
 	void setIncomingBuffer(const int* buffer, int size, int nodes, int thisNode);
+	/**
+	 * Set the pointer for the buffer containing the incoming VIP clauses which
+	 * is a concatenation of the data returned by giveVIPSelection for all the nodes.
+	 */
+	void setIncomingVIPBuffer(const int* buffer, int size);
 	/**
 	 * Fill the given clause with the literals of the next VIP clause.
 	 * Return false if no more VIP clauses.
@@ -59,11 +87,17 @@ private:
 	Mutex addClauseLock;
 	const int* incommingBuffer;
 	unsigned int size, nodes, thisNode;
-	unsigned int lastVipClsIndex, lastVipNode;
+	const int* incommingVipBuffer;
+	unsigned int vipSize, lastVipClsIndex;
 	unsigned int lastClsSize, lastClsIndex, lastClsNode, lastClsCount;
 
 	vector<Bucket*> buckets;
-	vector<vector<int> > vipClauses;
+	// store the clause with the given int in front of it (nothing if 0)
+	int* storeClause(int head, const int* lits, size_t len);
+	bool storeVIPClause(int head, const int* lits, size_t len, size_t limit);
+	// the VIP clauses separated by zeros, the vector keeps its capacity
+	vector<int> vipClauses;
+	int vipCount;
 };
 
 #endif /* CLAUSEDATABASE_H_ */
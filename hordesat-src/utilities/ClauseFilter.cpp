@@ -18,11 +18,10 @@ static unsigned const int primes [] = {2038072819, 2038073287,	2038073761,	20380
 		2038072823,	2038073321,	2038073767,	2038074319,
 		2038072847,	2038073341,	2038073789,	2038074329};
 
-size_t ClauseFilter::commutativeHashFunction(const vector<int>& cls, int which) {
+size_t ClauseFilter::commutativeHashFunction(const int* lits, size_t len, int which) {
 	size_t res = 0;
-	// skip the first int (it is the glue)
-	for (size_t j = 1; j < cls.size(); j++) {
-		int lit = cls[j];
+	for (size_t j = 0; j < len; j++) {
+		int lit = lits[j];
 		res ^= lit * primes[abs((which * lit) % NUM_PRIMES)];
 	}
 	return res % NUM_BITS;
@@ -41,11 +40,20 @@ bool ClauseFilter::registerClause(const vector<int>& cls) {
 	if (cls.size() == 1) {
 		return true;
 	}
+	// skip the first int (it is the glue)
+	return registerClause(cls.data() + 1, cls.size() - 1);
+}
+
+bool ClauseFilter::registerClause(const int* lits, size_t len) {
+	// unit clauses always get in
+	if (len == 1) {
+		return true;
+	}
 
-	size_t h1 = commutativeHashFunction(cls, 1);
-	size_t h2 = commutativeHashFunction(cls, 2);
-	size_t h3 = commutativeHashFunction(cls, 3);
-	size_t h4 = commutativeHashFunction(cls, 4);
+	size_t h1 = commutativeHashFunction(lits, len, 1);
+	size_t h2 = commutativeHashFunction(lits, len, 2);
+	size_t h3 = commutativeHashFunction(lits, len, 3);
+	size_t h4 = commutativeHashFunction(lits, len, 4);
 
 	if (s1->test(h1) && s1->test(h2) && s1->test(h3) && s1->test(h4)) {
 		return false;
@@ -26,6 +26,10 @@ public:
 	 * otherwise add it to the filter and return true.
 	 */
 	bool registerClause(const vector<int>& cls);
+	/**
+	 * The same for a clause given by its literals (without the glue).
+	 */
+	bool registerClause(const int* lits, size_t len);
 	/**
 	 * Clear the filter, i.e., return to its initial state.
 	 */
@@ -34,7 +38,7 @@ public:
 private:
 	bitset<NUM_BITS>* s1;
 	size_t hashFunction(const vector<int>& cls, int which);
-	size_t commutativeHashFunction(const vector<int>& cls, int which);
+	size_t commutativeHashFunction(const int* lits, size_t len, int which);
 
 };
 
@@ -0,0 +1,37 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * ClausePool.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#include "ClausePool.h"
+
+void ClausePool::append(vector<vector<int> >& clauses, const vector<int>& cls) {
+	// an empty vector does not allocate, it gets the storage of a spare one
+	clauses.push_back(vector<int>());
+	if (!spare.empty()) {
+		clauses.back().swap(spare.back());
+		spare.pop_back();
+	}
+	clauses.back().assign(cls.begin(), cls.end());
+}
+
+void ClausePool::recycle(vector<vector<int> >& clauses) {
+	for (size_t i = 0; i < clauses.size() && spare.size() < CLAUSE_POOL_MAX_SPARE; i++) {
+		spare.push_back(vector<int>());
+		spare.back().swap(clauses[i]);
+	}
+	clauses.clear();
+}
+
+size_t ClausePool::clear() {
+	size_t freed = 0;
+	for (size_t i = 0; i < spare.size(); i++) {
+		freed += sizeof(int)*spare[i].capacity();
+	}
+	freed += sizeof(vector<int>)*spare.capacity();
+	vector<vector<int> >().swap(spare);
+	return freed;
+}
@@ -0,0 +1,45 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * ClausePool.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#ifndef CLAUSEPOOL_H_
+#define CLAUSEPOOL_H_
+
+#include <vector>
+
+using namespace std;
+
+// vectors kept for reuse at most, the rest is freed
+#define CLAUSE_POOL_MAX_SPARE 100000
+
+/**
+ * Recycles the clause vectors of a sharing round. The clauses of a round are
+ * appended to a vector<vector<int> > with append and given back with recycle
+ * when the round is over, the next round reuses the vectors with their
+ * capacity, so after a few rounds no memory is allocated for the clauses.
+ * Not thread safe, every thread needs its own pool.
+ */
+class ClausePool {
+public:
+	/**
+	 * Append a copy of the clause to the clauses.
+	 */
+	void append(vector<vector<int> >& clauses, const vector<int>& cls);
+	/**
+	 * Take back the vectors of all the clauses, the clauses become empty.
+	 */
+	void recycle(vector<vector<int> >& clauses);
+	/**
+	 * Free the spare vectors, return the freed bytes.
+	 */
+	size_t clear();
+
+private:
+	vector<vector<int> > spare;
+};
+
+#endif /* CLAUSEPOOL_H_ */
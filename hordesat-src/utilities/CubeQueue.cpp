@@ -0,0 +1,217 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * CubeQueue.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#include "CubeQueue.h"
+#include "Logger.h"
+#include "../solvers/Lingeling.h"
+#include <stdlib.h>
+#include <algorithm>
+
+CubeQueue::CubeQueue() {
+	refutedWeight = 0;
+	refutedCount = 0;
+	splitCount = 0;
+}
+
+void CubeQueue::setWorkers(const vector<bool>& cubeWorkers) {
+	this->cubeWorkers = cubeWorkers;
+	workerCubeSize.assign(cubeWorkers.size(), -1);
+	splitRequests.assign(cubeWorkers.size(), false);
+}
+
+void CubeQueue::setSplitVariables(const vector<int>& vars) {
+	splitVariables = vars;
+}
+
+// With k cubes in the queue the k-th idle worker is woken up, the previous
+// ones were woken up for the other cubes
+int CubeQueue::add(const vector<int>& cube) {
+	lock.lock();
+	cubes.push_back(cube);
+	int worker = -1;
+	size_t idle = 0;
+	for (size_t i = 0; i < workerCubeSize.size(); i++) {
+		if (cubeWorkers[i] && workerCubeSize[i] < 0 && ++idle == cubes.size()) {
+			worker = i;
+			break;
+		}
+	}
+	lock.unlock();
+	return worker;
+}
+
+bool CubeQueue::take(vector<int>& cube, int worker) {
+	lock.lock();
+	if (cubes.empty()) {
+		lock.unlock();
+		return false;
+	}
+	cube.swap(cubes.front());
+	cubes.pop_front();
+	workerCubeSize[worker] = cube.size();
+	splitRequests[worker] = false;
+	lock.unlock();
+	return true;
+}
+
+bool CubeQueue::donate(vector<int>& cube) {
+	lock.lock();
+	if (cubes.empty()) {
+		lock.unlock();
+		return false;
+	}
+	cube.swap(cubes.front());
+	cubes.pop_front();
+	lock.unlock();
+	return true;
+}
+
+void CubeQueue::refuted(const vector<int>& cube, int worker) {
+	vector<int> cls;
+	if (cube.size() > 1) {
+		// the glue is not known, use the size (+1 as usual)
+		cls.push_back(1+cube.size());
+	}
+	for (size_t i = 0; i < cube.size(); i++) {
+		cls.push_back(-cube[i]);
+	}
+	lock.lock();
+	refutedClauses.push_back(cls);
+	refutedWeight += 1ULL << (CUBE_WEIGHT_BITS - cube.size());
+	refutedCount++;
+	workerCubeSize[worker] = -1;
+	splitRequests[worker] = false;
+	lock.unlock();
+}
+
+void CubeQueue::fetchRefutedClauses(vector<vector<int> >& clauses) {
+	clauses.clear();
+	lock.lock();
+	clauses.swap(refutedClauses);
+	lock.unlock();
+}
+
+bool CubeQueue::requestSplit(int& worker) {
+	lock.lock();
+	worker = -1;
+	for (size_t i = 0; i < workerCubeSize.size(); i++) {
+		int size = workerCubeSize[i];
+		if (size >= 0 && size < CUBE_WEIGHT_BITS && !splitRequests[i] &&
+				(worker < 0 || size < workerCubeSize[worker])) {
+			worker = i;
+		}
+	}
+	if (worker >= 0) {
+		splitRequests[worker] = true;
+	}
+	lock.unlock();
+	return worker >= 0;
+}
+
+bool CubeQueue::splitIfRequested(vector<int>& cube, int worker) {
+	lock.lock();
+	if (!splitRequests[worker]) {
+		lock.unlock();
+		return false;
+	}
+	splitRequests[worker] = false;
+	int var = 0;
+	for (size_t i = 0; i < splitVariables.size() && var == 0; i++) {
+		var = splitVariables[i];
+		for (size_t j = 0; j < cube.size(); j++) {
+			if (abs(cube[j]) == var) {
+				var = 0;
+				break;
+			}
+		}
+	}
+	if (var == 0 || cube.size() >= CUBE_WEIGHT_BITS) {
+		lock.unlock();
+		return false;
+	}
+	cubes.push_back(cube);
+	cubes.back().push_back(-var);
+	cube.push_back(var);
+	workerCubeSize[worker] = cube.size();
+	splitCount++;
+	lock.unlock();
+	return true;
+}
+
+size_t CubeQueue::size() {
+	lock.lock();
+	size_t res = cubes.size();
+	lock.unlock();
+	return res;
+}
+
+bool CubeQueue::hasIdleWorkers() {
+	lock.lock();
+	bool idle = false;
+	if (cubes.empty()) {
+		for (size_t i = 0; i < workerCubeSize.size(); i++) {
+			if (cubeWorkers[i] && workerCubeSize[i] < 0) {
+				idle = true;
+				break;
+			}
+		}
+	}
+	lock.unlock();
+	return idle;
+}
+
+// Each node of the cube tree is split on the lookahead variable of one
+// incremental Lingeling instance which gets the cube as assumptions.
+vector<vector<int> > generateCubes(vector<vector<int> >& formula, int depth) {
+	Lingeling lookahead;
+	lookahead.addInitialClauses(formula);
+	vector<vector<int> > cubes(1);
+	for (int level = 0; level < depth && level < CUBE_WEIGHT_BITS; level++) {
+		vector<vector<int> > next;
+		for (size_t i = 0; i < cubes.size(); i++) {
+			int var = lookahead.getSplittingVariable(cubes[i]);
+			if (var == 0) {
+				// nothing to split on (inconsistent or solved by propagation)
+				next.push_back(cubes[i]);
+				continue;
+			}
+			var = abs(var);
+			// it is assumed in the next level
+			lookahead.freezeVariable(var);
+			next.push_back(cubes[i]);
+			next.back().push_back(var);
+			next.push_back(cubes[i]);
+			next.back().push_back(-var);
+		}
+		cubes.swap(next);
+		log(2, "cube generation level %d: %lu cubes\n", level+1, cubes.size());
+	}
+	return cubes;
+}
+
+vector<int> getFrequentVariables(vector<vector<int> >& formula, size_t count) {
+	vector<pair<int, int> > occurrences;
+	for (size_t i = 0; i < formula.size(); i++) {
+		for (size_t j = 0; j < formula[i].size(); j++) {
+			size_t var = abs(formula[i][j]);
+			if (occurrences.size() <= var) {
+				occurrences.resize(var+1);
+			}
+			occurrences[var].first--;
+			occurrences[var].second = var;
+		}
+	}
+	sort(occurrences.begin(), occurrences.end());
+	vector<int> vars;
+	for (size_t i = 0; i < occurrences.size() && vars.size() < count; i++) {
+		if (occurrences[i].first < 0) {
+			vars.push_back(occurrences[i].second);
+		}
+	}
+	return vars;
+}
@@ -0,0 +1,109 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * CubeQueue.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#ifndef CUBEQUEUE_H_
+#define CUBEQUEUE_H_
+
+#include <vector>
+#include <deque>
+#include "Threading.h"
+
+using namespace std;
+
+// A cube with k literals covers 2^(CUBE_WEIGHT_BITS-k) of the search space
+// (all the cubes are leaves of one binary tree), the formula is unsatisfiable
+// when the refuted cubes of all the nodes weigh 2^CUBE_WEIGHT_BITS.
+#define CUBE_WEIGHT_BITS 62
+// how many frequent variables are frozen to be used for splitting cubes
+#define CUBE_SPLIT_VARIABLES 64
+
+/**
+ * The cubes (lists of assumption literals) of a node waiting to be solved.
+ * The solver threads (workers) take the cubes one by one, so a thread that
+ * refuted its cube continues with the next one while the others are still
+ * busy. A worker can be asked to split its cube, it then keeps one half and
+ * puts the other one into the queue.
+ */
+class CubeQueue {
+public:
+	CubeQueue();
+
+	// only the workers marked true take cubes
+	void setWorkers(const vector<bool>& cubeWorkers);
+	// the variables that can be used for splitting, they have to be frozen
+	void setSplitVariables(const vector<int>& vars);
+
+	/**
+	 * Add the cube to the queue, return an idle worker that should be
+	 * interrupted to take it or -1 if there is none.
+	 */
+	int add(const vector<int>& cube);
+	/**
+	 * Take the next cube for the worker, return false if there is none.
+	 */
+	bool take(vector<int>& cube, int worker);
+	/**
+	 * Take the next cube to give it to another node, return false if there is none.
+	 */
+	bool donate(vector<int>& cube);
+	/**
+	 * Record that the cube of the worker was refuted, the negation
+	 * of the cube is stored so it can be given to the solvers as a clause.
+	 */
+	void refuted(const vector<int>& cube, int worker);
+	/**
+	 * Move the negations of the refuted cubes since the last call into clauses
+	 * in the learned clause format (glue first, units without glue).
+	 */
+	void fetchRefutedClauses(vector<vector<int> >& clauses);
+
+	/**
+	 * Ask the worker with the shortest (largest) cube to split it,
+	 * return false if no worker has a splittable cube.
+	 */
+	bool requestSplit(int& worker);
+	/**
+	 * Called by the worker, if it was asked to split its cube, extend the cube
+	 * by a split variable and add the other half to the queue.
+	 * Return true if the cube was split.
+	 */
+	bool splitIfRequested(vector<int>& cube, int worker);
+
+	size_t size();
+	// true if the queue is empty and some cube worker has no cube
+	bool hasIdleWorkers();
+	unsigned long long getRefutedWeight() {
+		return refutedWeight;
+	}
+	int getRefutedCount() {
+		return refutedCount;
+	}
+	int getSplitCount() {
+		return splitCount;
+	}
+
+private:
+	Mutex lock;
+	deque<vector<int> > cubes;
+	vector<vector<int> > refutedClauses;
+	vector<int> splitVariables;
+	vector<bool> cubeWorkers;
+	// cube size of each worker, -1 if it has no cube
+	vector<int> workerCubeSize;
+	vector<bool> splitRequests;
+	volatile unsigned long long refutedWeight;
+	volatile int refutedCount;
+	volatile int splitCount;
+};
+
+// Split the formula into 2^depth cubes (or less) using the lookahead of Lingeling
+vector<vector<int> > generateCubes(vector<vector<int> >& formula, int depth);
+// The most frequent variables of the formula
+vector<int> getFrequentVariables(vector<vector<int> >& formula, size_t count);
+
+#endif /* CUBEQUEUE_H_ */
@@ -0,0 +1,126 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * Diversification.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#include "Diversification.h"
+#include <algorithm>
+
+static const OptionRange options[] = {
+	{"lingeling", "phase", -1, 1},
+	{"lingeling", "bias", -1, 2},
+	{"lingeling", "restartint", 10, 1000},
+	{"lingeling", "reduceinit", 1000, 20000},
+	{"lingeling", "reduceinc", 100, 1000},
+	{"lingeling", "gluescale", 0, 5},
+	{"lingeling", "agilelim", 10, 100},
+	{"lingeling", "acts", 0, 2},
+	{"lingeling", "flipping", 0, 1},
+	{"lingeling", "move", 0, 1},
+	{"lingeling", "elmrtc", 0, 1},
+	{"lingeling", "blkrtc", 0, 1},
+	{"minisat", "luby", 0, 1},
+	{"minisat", "rfirst", 25, 400},
+	{"minisat", "rinc", 150, 400},
+	{"minisat", "var-decay", 800, 990},
+	{"minisat", "rnd-freq", 0, 50},
+	{"minisat", "ccmin-mode", 0, 2},
+	{"minisat", "phase-saving", 0, 2},
+	{"minisat", "rnd-init", 0, 1},
+	{"cadical", "restartint", 1, 100},
+	{"cadical", "reluctant", 0, 2048},
+	{"cadical", "stabilize", 0, 1},
+	{"cadical", "phase", 0, 1},
+	{"cadical", "chrono", 0, 2},
+	{"cadical", "elim", 0, 1},
+	{"cadical", "subsume", 0, 1},
+	{"cadical", "walk", 0, 1},
+	{"kissat", "restartint", 1, 100},
+	{"kissat", "stable", 0, 2},
+	{"kissat", "phase", 0, 1},
+	{"kissat", "chrono", 0, 1},
+	{"kissat", "tumble", 0, 1},
+	{"kissat", "eliminate", 0, 1},
+	{"probsat", "cb", 200, 300},
+};
+
+// splitmix64, a good generator for seeds that differ in a few bits
+static unsigned long long nextRandom(unsigned long long& state) {
+	unsigned long long z = (state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+static unsigned long long stringHash(const string& str) {
+	unsigned long long hash = 14695981039346656037ULL;
+	for (size_t i = 0; i < str.size(); i++) {
+		hash = (hash ^ (unsigned char)str[i]) * 1099511628211ULL;
+	}
+	return hash;
+}
+
+vector<pair<string, int> > sampleOptions(const string& solver, int slot) {
+	vector<const OptionRange*> candidates;
+	for (size_t i = 0; i < sizeof(options)/sizeof(OptionRange); i++) {
+		if (solver == options[i].solver) {
+			candidates.push_back(&options[i]);
+		}
+	}
+	vector<pair<string, int> > result;
+	if (slot == 0 || candidates.empty()) {
+		return result;
+	}
+	unsigned long long state = stringHash(solver) ^ (unsigned long long)slot;
+	int changes = 1 + nextRandom(state) % min((int)candidates.size(), DIVERSIFY_MAX_CHANGES);
+	for (int i = 0; i < changes; i++) {
+		// partial Fisher-Yates shuffle, every option is changed at most once
+		int pick = i + nextRandom(state) % (candidates.size() - i);
+		swap(candidates[i], candidates[pick]);
+		const OptionRange* opt = candidates[i];
+		int value = opt->min + nextRandom(state) % (opt->max - opt->min + 1);
+		result.push_back(make_pair(string(opt->name), value));
+	}
+	sort(result.begin(), result.end());
+	return result;
+}
+
+vector<pair<string, int> > mutateOptions(const string& solver, const vector<pair<string, int> >& current,
+		unsigned long long seed) {
+	vector<const OptionRange*> candidates;
+	for (size_t i = 0; i < sizeof(options)/sizeof(OptionRange); i++) {
+		if (solver == options[i].solver) {
+			candidates.push_back(&options[i]);
+		}
+	}
+	vector<pair<string, int> > result(current);
+	if (candidates.empty()) {
+		return result;
+	}
+	unsigned long long state = stringHash(solver) ^ seed;
+	const OptionRange* opt = candidates[nextRandom(state) % candidates.size()];
+	int value = opt->min + nextRandom(state) % (opt->max - opt->min + 1);
+	size_t i = 0;
+	while (i < result.size() && result[i].first != opt->name) {
+		i++;
+	}
+	if (i == result.size()) {
+		result.push_back(make_pair(string(opt->name), value));
+	} else {
+		result[i].second = value;
+	}
+	sort(result.begin(), result.end());
+	return result;
+}
+
+unsigned long long configurationHash(const string& solver, const vector<pair<string, int> >& options) {
+	unsigned long long hash = stringHash(solver);
+	for (size_t i = 0; i < options.size(); i++) {
+		hash = hash * 31 + stringHash(options[i].first);
+		hash = hash * 31 + (unsigned long long)options[i].second;
+	}
+	return hash;
+}
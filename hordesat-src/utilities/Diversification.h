@@ -0,0 +1,49 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * Diversification.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#ifndef DIVERSIFICATION_H_
+#define DIVERSIFICATION_H_
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// at most this many options are changed in one configuration
+#define DIVERSIFY_MAX_CHANGES 4
+
+// an option that can be given to PortfolioSolverInterface::setOption and
+// the range its value is sampled from
+struct OptionRange {
+	const char* solver;
+	const char* name;
+	int min;
+	int max;
+};
+
+/**
+ * Sample the options of a solver slot. The choice only depends on the solver
+ * and the slot number, so it is the same in every run. Slot 0 keeps the
+ * defaults, the other slots get 1 to DIVERSIFY_MAX_CHANGES changed options
+ * (restart, decay, phase, simplification settings).
+ */
+vector<pair<string, int> > sampleOptions(const string& solver, int slot);
+
+/**
+ * Return a copy of the options with one option of the solver set to a new
+ * random value (added if not present), the seed decides which one.
+ */
+vector<pair<string, int> > mutateOptions(const string& solver, const vector<pair<string, int> >& current,
+		unsigned long long seed);
+
+/**
+ * Hash of a configuration, used to count the distinct configurations.
+ */
+unsigned long long configurationHash(const string& solver, const vector<pair<string, int> >& options);
+
+#endif /* DIVERSIFICATION_H_ */
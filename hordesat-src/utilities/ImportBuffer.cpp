@@ -0,0 +1,60 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * ImportBuffer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#include "ImportBuffer.h"
+
+ImportBuffer::ImportBuffer():frontPos(0),addedCount(0),consumedCount(0) {
+}
+
+void ImportBuffer::addUnlocked(const vector<int>& cls) {
+	back.insert(back.end(), cls.begin(), cls.end());
+	back.push_back(0);
+	addedCount++;
+}
+
+void ImportBuffer::add(const vector<int>& cls) {
+	lock.lock();
+	addUnlocked(cls);
+	lock.unlock();
+}
+
+void ImportBuffer::add(const vector<vector<int> >& clauses) {
+	lock.lock();
+	for (size_t i = 0; i < clauses.size(); i++) {
+		if (clauses[i].size() > 1) {
+			addUnlocked(clauses[i]);
+		}
+	}
+	lock.unlock();
+}
+
+int* ImportBuffer::next(int* glue) {
+	if (frontPos >= front.size()) {
+		// the front buffer is exhausted, try to swap in the back buffer
+		if (lock.tryLock() == false) {
+			return NULL;
+		}
+		front.clear();
+		front.swap(back);
+		lock.unlock();
+		frontPos = 0;
+		if (front.empty()) {
+			return NULL;
+		}
+	}
+	*glue = front[frontPos];
+	int* cls = &front[frontPos+1];
+	// skip to the next clause
+	frontPos++;
+	while (front[frontPos] != 0) {
+		frontPos++;
+	}
+	frontPos++;
+	consumedCount++;
+	return cls;
+}
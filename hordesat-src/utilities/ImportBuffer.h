@@ -0,0 +1,69 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * ImportBuffer.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#ifndef IMPORTBUFFER_H_
+#define IMPORTBUFFER_H_
+
+#include <vector>
+#include "Threading.h"
+
+using namespace std;
+
+/**
+ * Double buffered queue of learned clauses waiting to be imported by a solver.
+ * The clauses are stored zero terminated in flat arrays, each one preceded by
+ * its glue. The sharing thread appends to the back buffer under a lock, the
+ * solver thread reads the front buffer without locking and only takes the lock
+ * to swap the buffers when the front one is exhausted. The buffers keep their
+ * capacity, so after a few rounds no memory is allocated at all.
+ */
+class ImportBuffer {
+public:
+	ImportBuffer();
+
+	/**
+	 * Add a clause (the first int is the glue), can be called from any thread.
+	 */
+	void add(const vector<int>& cls);
+	/**
+	 * Add all the non-unit clauses (the first int is the glue) from the vector.
+	 */
+	void add(const vector<vector<int> >& clauses);
+	/**
+	 * Return the next zero terminated clause and store its glue, or return NULL
+	 * if there are no more clauses. The returned pointer is valid until the next
+	 * call. Only one thread (the solver) may call this method.
+	 */
+	int* next(int* glue);
+
+	unsigned long getAddedCount() {
+		return addedCount;
+	}
+	unsigned long getConsumedCount() {
+		return consumedCount;
+	}
+	/**
+	 * The clauses waiting for the solver, only approximate if called
+	 * by another thread than the solver.
+	 */
+	unsigned long getPendingCount() {
+		return addedCount - consumedCount;
+	}
+
+private:
+	Mutex lock;
+	vector<int> back;
+	vector<int> front;
+	size_t frontPos;
+	unsigned long addedCount;
+	unsigned long consumedCount;
+
+	void addUnlocked(const vector<int>& cls);
+};
+
+#endif /* IMPORTBUFFER_H_ */
@@ -0,0 +1,265 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * InprocessingWorker.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#include "InprocessingWorker.h"
+#include "Logger.h"
+#include <unistd.h>
+#include <algorithm>
+
+void* inprocessingThread(void* arg) {
+	InprocessingWorker* worker = (InprocessingWorker*)arg;
+	worker->run();
+	return NULL;
+}
+
+InprocessingWorker::InprocessingWorker(vector<vector<int> >& formula, ClauseDatabase& cdb):cdb(cdb) {
+	stopWorker = false;
+	unsat = false;
+	droppedClauses = 0;
+	propagated = 0;
+	numVars = 0;
+	for (size_t i = 0; i < formula.size(); i++) {
+		for (size_t j = 0; j < formula[i].size(); j++) {
+			numVars = max(numVars, abs(formula[i][j]));
+		}
+	}
+	values.assign(numVars+1, 0);
+	watches.resize(2*numVars+2);
+	occurrences.resize(2*numVars+2);
+	vector<int> cls;
+	for (size_t i = 0; i < formula.size() && !unsat; i++) {
+		cls = formula[i];
+		sort(cls.begin(), cls.end());
+		cls.erase(unique(cls.begin(), cls.end()), cls.end());
+		bool tautology = false;
+		for (size_t j = 0; j < cls.size() && !tautology; j++) {
+			tautology = cls[j] < 0 && binary_search(cls.begin(), cls.end(), -cls[j]);
+		}
+		if (tautology) {
+			continue;
+		}
+		if (cls.size() <= 1) {
+			if (cls.empty() || value(cls[0]) < 0) {
+				unsat = true;
+			} else if (value(cls[0]) == 0) {
+				assign(cls[0]);
+			}
+			continue;
+		}
+		int c = clauseStart.size();
+		clauseStart.push_back(literals.size());
+		for (size_t j = 0; j < cls.size(); j++) {
+			literals.push_back(cls[j]);
+			occurrences[litIndex(cls[j])].push_back(c);
+		}
+		literals.push_back(0);
+		watches[litIndex(cls[0])].push_back(c);
+		watches[litIndex(cls[1])].push_back(c);
+	}
+	unsat = unsat || !propagate();
+	if (unsat) {
+		log(1, "inprocessing found the formula unsatisfiable\n");
+	}
+	thread = new Thread(inprocessingThread, this);
+}
+
+InprocessingWorker::~InprocessingWorker() {
+	stopWorker = true;
+	thread->join();
+	delete thread;
+}
+
+void InprocessingWorker::addClause(const int* lits, size_t len, int glue) {
+	if (len > INPROC_MAX_CLAUSE_SIZE || !queueLock.tryLock()) {
+		droppedClauses++;
+		return;
+	}
+	if (queue.size() < INPROC_QUEUE_LIMIT) {
+		// queued in the shared format, the first int of non-unit clauses is 1+glue
+		queue.push_back(vector<int>());
+		if (len > 1) {
+			queue.back().push_back(1 + glue);
+		}
+		queue.back().insert(queue.back().end(), lits, lits + len);
+	} else {
+		droppedClauses++;
+	}
+	queueLock.unlock();
+}
+
+void InprocessingWorker::assign(int lit) {
+	values[abs(lit)] = lit > 0 ? 1 : -1;
+	trail.push_back(lit);
+}
+
+// Two watched literals propagation, return false on conflict
+bool InprocessingWorker::propagate() {
+	while (propagated < trail.size()) {
+		int lit = trail[propagated++];
+		vector<int>& ws = watches[litIndex(-lit)];
+		size_t j = 0;
+		for (size_t i = 0; i < ws.size(); i++) {
+			int c = ws[i];
+			int* cls = &literals[clauseStart[c]];
+			if (cls[0] == -lit) {
+				cls[0] = cls[1];
+				cls[1] = -lit;
+			}
+			if (value(cls[0]) > 0) {
+				ws[j++] = c;
+				continue;
+			}
+			bool moved = false;
+			for (int k = 2; cls[k] != 0; k++) {
+				if (value(cls[k]) >= 0) {
+					cls[1] = cls[k];
+					cls[k] = -lit;
+					watches[litIndex(cls[1])].push_back(c);
+					moved = true;
+					break;
+				}
+			}
+			if (moved) {
+				continue;
+			}
+			ws[j++] = c;
+			if (value(cls[0]) < 0) {
+				for (i++; i < ws.size(); i++) {
+					ws[j++] = ws[i];
+				}
+				ws.resize(j);
+				return false;
+			}
+			assign(cls[0]);
+		}
+		ws.resize(j);
+	}
+	return true;
+}
+
+void InprocessingWorker::backtrack(size_t level) {
+	while (trail.size() > level) {
+		values[abs(trail.back())] = 0;
+		trail.pop_back();
+	}
+	propagated = level;
+}
+
+// Return true if a clause of the formula is a subset of the literals
+bool InprocessingWorker::isSubsumed(vector<int>& lits) {
+	int minLit = lits[0];
+	for (size_t i = 1; i < lits.size(); i++) {
+		if (occurrences[litIndex(lits[i])].size() < occurrences[litIndex(minLit)].size()) {
+			minLit = lits[i];
+		}
+	}
+	vector<int>& occ = occurrences[litIndex(minLit)];
+	if (occ.size() > INPROC_SUBSUME_OCC_LIMIT) {
+		return false;
+	}
+	for (size_t i = 0; i < occ.size(); i++) {
+		// the literals of the clause are reordered by the watching
+		bool subset = true;
+		for (int* l = &literals[clauseStart[occ[i]]]; *l != 0 && subset; l++) {
+			subset = find(lits.begin(), lits.end(), *l) != lits.end();
+		}
+		if (subset) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Falsify the literals of the clause one by one, if propagation finds a
+// conflict or makes a literal true, the clause can be shortened. Literals
+// made false are removed. Return true if the clause was exported.
+bool InprocessingWorker::vivify(vector<int>& clause) {
+	// skipping the first int containing the glue
+	for (size_t i = clause.size() == 1 ? 0 : 1; i < clause.size(); i++) {
+		if (abs(clause[i]) > numVars) {
+			return false;
+		}
+	}
+	if (clause.size() == 1) {
+		if (value(clause[0]) == 0) {
+			assign(clause[0]);
+			unsat = !propagate();
+		}
+		return false;
+	}
+	stats.checkedClauses++;
+	int glue = clause[0] - 1;
+	vector<int> lits;
+	for (size_t i = 1; i < clause.size(); i++) {
+		int val = value(clause[i]);
+		if (val > 0) {
+			return false;
+		}
+		if (val == 0) {
+			lits.push_back(clause[i]);
+		}
+	}
+	if (lits.empty()) {
+		return false;
+	}
+
+	size_t root = trail.size();
+	vector<int> result;
+	for (size_t i = 0; i < lits.size(); i++) {
+		int val = value(lits[i]);
+		if (val < 0) {
+			continue;
+		}
+		result.push_back(lits[i]);
+		if (val > 0) {
+			break;
+		}
+		assign(-lits[i]);
+		if (!propagate()) {
+			break;
+		}
+	}
+	backtrack(root);
+	if (result.size() == clause.size() - 1) {
+		return false;
+	}
+	if (isSubsumed(result)) {
+		stats.subsumedClauses++;
+		return false;
+	}
+	stats.strengthenedClauses++;
+	stats.removedLiterals += clause.size() - 1 - result.size();
+	vector<int> strengthened;
+	if (result.size() == 1) {
+		assign(result[0]);
+		unsat = !propagate();
+	} else {
+		// to avoid zeros in the array, 1 is added to the glue
+		strengthened.push_back(1 + min(glue, (int)result.size()));
+	}
+	strengthened.insert(strengthened.end(), result.begin(), result.end());
+	cdb.addVIPClause(strengthened);
+	return true;
+}
+
+void InprocessingWorker::run() {
+	while (!stopWorker) {
+		queueLock.lock();
+		batch.swap(queue);
+		queueLock.unlock();
+		if (batch.empty() || unsat) {
+			batch.clear();
+			usleep(10000);
+			continue;
+		}
+		for (size_t i = 0; i < batch.size() && !stopWorker && !unsat; i++) {
+			vivify(batch[i]);
+		}
+		batch.clear();
+	}
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * InprocessingWorker.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#ifndef INPROCESSINGWORKER_H_
+#define INPROCESSINGWORKER_H_
+
+#include <stdlib.h>
+#include <vector>
+#include <atomic>
+#include "Threading.h"
+#include "ClauseDatabase.h"
+
+using namespace std;
+
+// learned clauses waiting for vivification, more are dropped
+#define INPROC_QUEUE_LIMIT 10000
+// longer learned clauses are not vivified
+#define INPROC_MAX_CLAUSE_SIZE 30
+// occurrence lists longer than this are not searched for subsuming clauses
+#define INPROC_SUBSUME_OCC_LIMIT 1000
+
+struct InprocessingStatistics {
+	InprocessingStatistics():checkedClauses(0),droppedClauses(0),subsumedClauses(0),
+			strengthenedClauses(0),removedLiterals(0) {}
+	unsigned long checkedClauses;
+	// not checked because the queue was full or locked
+	unsigned long droppedClauses;
+	// learned clauses subsumed by the formula, they are not exported
+	unsigned long subsumedClauses;
+	unsigned long strengthenedClauses;
+	unsigned long removedLiterals;
+};
+
+/**
+ * A helper thread that vivifies the clauses learned by the local solvers
+ * against the formula: the literals of a clause are falsified one by one
+ * and unit propagation over the formula is used to find a shorter implied
+ * subclause. Strengthened clauses that are not subsumed by the formula are
+ * exported as VIP clauses, so every solver of every node gets them.
+ */
+class InprocessingWorker {
+public:
+	InprocessingWorker(vector<vector<int> >& formula, ClauseDatabase& cdb);
+	~InprocessingWorker();
+
+	/**
+	 * Queue a learned clause for vivification. Does not block, the clause is
+	 * dropped if the queue is busy or full. Units are only used to simplify
+	 * later clauses.
+	 */
+	void addClause(const int* lits, size_t len, int glue);
+
+	InprocessingStatistics getStatistics() {
+		InprocessingStatistics st = stats;
+		st.droppedClauses = droppedClauses;
+		return st;
+	}
+
+private:
+	ClauseDatabase& cdb;
+	Thread* thread;
+	volatile bool stopWorker;
+	bool unsat;
+
+	Mutex queueLock;
+	vector<vector<int> > queue;
+	vector<vector<int> > batch;
+
+	// the formula, each clause starts at clauseStart[c] and is terminated by 0
+	vector<int> literals;
+	vector<int> clauseStart;
+	// clauses watched by the two first literals, indexed by litIndex
+	vector<vector<int> > watches;
+	// clauses containing the literal, used for the subsumption check
+	vector<vector<int> > occurrences;
+	vector<signed char> values;
+	vector<int> trail;
+	size_t propagated;
+	int numVars;
+
+	InprocessingStatistics stats;
+	// counted by the solver threads in addClause
+	atomic<unsigned long> droppedClauses;
+
+	int litIndex(int lit) {
+		return 2*abs(lit) + (lit < 0);
+	}
+	int value(int lit) {
+		if (abs(lit) > numVars) {
+			return 0;
+		}
+		return lit > 0 ? values[lit] : -values[-lit];
+	}
+	void assign(int lit);
+	bool propagate();
+	void backtrack(size_t level);
+	bool isSubsumed(vector<int>& lits);
+	bool vivify(vector<int>& clause);
+	void run();
+	friend void* inprocessingThread(void* arg);
+};
+
+#endif /* INPROCESSINGWORKER_H_ */
@@ -7,17 +7,47 @@
  */
 
 #include "Logger.h"
-#include <sys/time.h>
+#include "Threading.h"
+#include <time.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <unistd.h>
+#include <atomic>
+#include <vector>
+#include <algorithm>
 
-static int verbosityLevelSetting = 0;
+using namespace std;
+
+struct LogMessage {
+	double time;
+	int thread;
+	char text[LOG_MESSAGE_SIZE];
+};
+
+// The messages of one thread, written by it and read by the writer
+struct LogRing {
+	int thread;
+	LogMessage messages[LOG_RING_SIZE];
+	atomic<unsigned long> head;
+	atomic<unsigned long> tail;
+};
+
+int verbosityLevelSetting = 0;
 static double start = getAbsoluteTime();
 
+static int logRank = 0;
+static Mutex ringsLock;
+static vector<LogRing*> rings;
+static __thread LogRing* threadRing = NULL;
+
+static Mutex writeLock;
+static Thread* writer = NULL;
+static volatile bool writerRunning = false;
+
 double getAbsoluteTime() {
-	timeval time;
-	gettimeofday(&time, NULL);
-	return (double)time.tv_sec + (double)time.tv_usec * .000001;
+	timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (double)time.tv_sec + (double)time.tv_nsec * .000000001;
 }
 
 double getTime() {
@@ -28,16 +58,98 @@ void setVerbosityLevel(int level) {
 	verbosityLevelSetting = level;
 }
 
-void log(int verbosityLevel, const char* fmt ...) {
-	if (verbosityLevel <= verbosityLevelSetting) {
-		va_list args;
-		va_start(args, fmt);
-		printf("[%.2f] ", getTime());
-		vprintf(fmt, args);
-		va_end(args);
+static LogRing* getLogRing() {
+	if (threadRing == NULL) {
+		threadRing = new LogRing();
+		threadRing->head = 0;
+		threadRing->tail = 0;
+		ringsLock.lock();
+		threadRing->thread = rings.size();
+		rings.push_back(threadRing);
+		ringsLock.unlock();
+	}
+	return threadRing;
+}
+
+static bool earlier(const LogMessage* a, const LogMessage* b) {
+	return a->time < b->time;
+}
+
+void flushLog() {
+	writeLock.lock();
+	ringsLock.lock();
+	vector<LogRing*> current(rings);
+	ringsLock.unlock();
+	vector<unsigned long> heads(current.size());
+	vector<LogMessage*> batch;
+	for (size_t i = 0; i < current.size(); i++) {
+		heads[i] = current[i]->head.load(memory_order_acquire);
+		for (unsigned long m = current[i]->tail.load(memory_order_relaxed); m < heads[i]; m++) {
+			batch.push_back(&current[i]->messages[m % LOG_RING_SIZE]);
+		}
+	}
+	// the messages of each thread are in order already
+	stable_sort(batch.begin(), batch.end(), earlier);
+	for (size_t i = 0; i < batch.size(); i++) {
+		fputs(batch[i]->text, stdout);
 	}
+	if (!batch.empty()) {
+		fflush(stdout);
+	}
+	for (size_t i = 0; i < current.size(); i++) {
+		current[i]->tail.store(heads[i], memory_order_release);
+	}
+	writeLock.unlock();
 }
 
+void logMessage(int verbosityLevel, const char* fmt ...) {
+	LogRing* ring = getLogRing();
+	unsigned long head = ring->head.load(memory_order_relaxed);
+	while (head - ring->tail.load(memory_order_acquire) >= LOG_RING_SIZE) {
+		// full, the messages are not dropped
+		if (writerRunning) {
+			usleep(100);
+		} else {
+			flushLog();
+		}
+	}
+	LogMessage& msg = ring->messages[head % LOG_RING_SIZE];
+	msg.time = getTime();
+	msg.thread = ring->thread;
+	int len = snprintf(msg.text, LOG_MESSAGE_SIZE, "[%.2f] [%d:%d] ", msg.time, logRank, ring->thread);
+	va_list args;
+	va_start(args, fmt);
+	int textLen = vsnprintf(msg.text + len, LOG_MESSAGE_SIZE - len, fmt, args);
+	va_end(args);
+	if (len + textLen >= LOG_MESSAGE_SIZE) {
+		msg.text[LOG_MESSAGE_SIZE - 2] = '\n';
+	}
+	ring->head.store(head + 1, memory_order_release);
+	if (!writerRunning) {
+		flushLog();
+	}
+}
 
+static void* writerThread(void* arg) {
+	while (writerRunning) {
+		flushLog();
+		usleep(LOG_WRITE_INTERVAL);
+	}
+	return NULL;
+}
 
+void startLogger(int rank) {
+	logRank = rank;
+	writerRunning = true;
+	writer = new Thread(writerThread, NULL);
+}
 
+void stopLogger() {
+	if (writer != NULL) {
+		writerRunning = false;
+		writer->join();
+		delete writer;
+		writer = NULL;
+	}
+	flushLog();
+}
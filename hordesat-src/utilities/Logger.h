@@ -9,10 +9,46 @@
 #ifndef LOGGER_H_
 #define LOGGER_H_
 
+// messages with a higher verbosity level are removed by the compiler
+#ifndef LOG_MAX_LEVEL
+#define LOG_MAX_LEVEL 3
+#endif
+// messages are cut to this length
+#define LOG_MESSAGE_SIZE 1024
+// messages each thread can have waiting for the writer
+#define LOG_RING_SIZE 256
+// microseconds between two writes of the background writer
+#define LOG_WRITE_INTERVAL 10000
+
+extern int verbosityLevelSetting;
+
 double getTime();
 double getAbsoluteTime();
 void setVerbosityLevel(int level);
-void log(int verbosityLevel, const char* fmt ...);
+void logMessage(int verbosityLevel, const char* fmt ...);
+
+/**
+ * The messages are formatted by the calling thread into its own buffer and
+ * written to stdout by a background thread (after startLogger), tagged with
+ * the time, the rank and the thread.
+ */
+template<typename... Args>
+inline void log(int verbosityLevel, const char* fmt, Args... args) {
+	if (verbosityLevel <= LOG_MAX_LEVEL && verbosityLevel <= verbosityLevelSetting) {
+		logMessage(verbosityLevel, fmt, args...);
+	}
+}
+
+/**
+ * Start the background writer, before it runs each thread writes its own
+ * messages.
+ */
+void startLogger(int rank);
+/**
+ * Write all the waiting messages now, call before writing to stdout directly.
+ */
+void flushLog();
+void stopLogger();
 
 
 #endif /* LOGGER_H_ */
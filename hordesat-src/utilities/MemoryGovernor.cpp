@@ -0,0 +1,158 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * MemoryGovernor.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#include "MemoryGovernor.h"
+#include "Logger.h"
+#include <stdio.h>
+#include <unistd.h>
+
+MemoryGovernor::MemoryGovernor(vector<PortfolioSolverInterface*>& solvers, const vector<bool>& stoppable,
+		const vector<bool>& reducible, SharingManagerInterface* sharing, double budget, int rank)
+	:solvers(solvers),stoppable(stoppable),reducible(reducible),sharing(sharing),budget(budget),rank(rank),
+	 nextActionRound(0),reductions(0),stoppedCount(0),peakMemory(0) {
+	pendingReduce.resize(solvers.size(), false);
+	stopped.resize(solvers.size(), false);
+	exited.resize(solvers.size(), false);
+}
+
+double MemoryGovernor::getResidentMemory() {
+	FILE* f = fopen("/proc/self/statm", "r");
+	if (f == NULL) {
+		return 0;
+	}
+	unsigned long size = 0, resident = 0;
+	int read = fscanf(f, "%lu %lu", &size, &resident);
+	fclose(f);
+	if (read != 2) {
+		return 0;
+	}
+	return resident * (double)sysconf(_SC_PAGESIZE) / (1024*1024);
+}
+
+void MemoryGovernor::check(int round) {
+	releaseExited();
+	double memory = getResidentMemory();
+	if (memory > peakMemory) {
+		peakMemory = memory;
+	}
+	if (round < nextActionRound || memory < MEM_REDUCE_RATIO * budget) {
+		return;
+	}
+	nextActionRound = round + MEM_ACTION_DELAY;
+	for (size_t sid = 0; sid < solvers.size(); sid++) {
+		if (solvers[sid] != NULL) {
+			log(1, "memory: node %d solver %lu%s reports %.1f MB\n", rank, sid, stopped[sid] ? " (stopped)" : "",
+					solvers[sid]->getStatistics().memCurrent);
+		}
+	}
+	if (memory >= MEM_STOP_RATIO * budget) {
+		stopWeakest(memory);
+	}
+	reduce(memory);
+}
+
+// Apart from its own thread only the main thread uses a stopped solver
+// (stopAllSolvers and checkCubes skip it), so it can be deleted here once
+// its thread does not use it any more
+void MemoryGovernor::releaseExited() {
+	for (size_t sid = 0; sid < solvers.size(); sid++) {
+		lock.lock();
+		bool release = exited[sid] && solvers[sid] != NULL;
+		lock.unlock();
+		if (release) {
+			delete solvers[sid];
+			solvers[sid] = NULL;
+			log(1, "memory: node %d released the stopped solver %lu\n", rank, sid);
+		}
+	}
+}
+
+void MemoryGovernor::reduce(double memory) {
+	int asked = 0;
+	lock.lock();
+	for (size_t sid = 0; sid < solvers.size(); sid++) {
+		if (!stopped[sid] && reducible[sid]) {
+			pendingReduce[sid] = true;
+			solvers[sid]->setSolverInterrupt();
+			asked++;
+		}
+	}
+	lock.unlock();
+	size_t freed = 0;
+	if (sharing != NULL) {
+		freed = sharing->shrinkBuffers();
+	}
+	reductions++;
+	log(0, "memory: node %d uses %.0f of %.0f MB, %d solvers reduce their clause databases, "
+			"%.1f MB of sharing buffers freed\n", rank, memory, budget, asked, freed / (1024.0*1024));
+}
+
+void MemoryGovernor::stopWeakest(double memory) {
+	int running = 0;
+	int weakest = -1;
+	double weakestScore = 0;
+	for (size_t sid = 0; sid < solvers.size(); sid++) {
+		if (stopped[sid]) {
+			continue;
+		}
+		running++;
+		if (!stoppable[sid]) {
+			continue;
+		}
+		double score = solvers[sid]->getStatistics().conflicts;
+		if (sharing != NULL) {
+			SolverExportStatistics ex = sharing->getSolverStatistics(sid);
+			if (ex.exportedClauses > 0) {
+				double avgGlue = ex.glueSum / (double)ex.exportedClauses;
+				score += MEM_EXPORT_WEIGHT * ex.exportedClauses / (1 + avgGlue);
+			}
+		}
+		if (weakest == -1 || score < weakestScore) {
+			weakest = sid;
+			weakestScore = score;
+		}
+	}
+	if (weakest == -1 || running < 2) {
+		log(0, "memory: node %d uses %.0f of %.0f MB, no solver can be stopped\n", rank, memory, budget);
+		return;
+	}
+	lock.lock();
+	stopped[weakest] = true;
+	lock.unlock();
+	// the solver thread checks the flag after it was interrupted
+	solvers[weakest]->setSolverInterrupt();
+	if (sharing != NULL) {
+		sharing->removeSolver(weakest);
+	}
+	stoppedCount++;
+	log(0, "memory: node %d uses %.0f of %.0f MB, stopped the weakest solver %d (score %.0f)\n",
+			rank, memory, budget, weakest, weakestScore);
+}
+
+void MemoryGovernor::applyPending(int sid) {
+	lock.lock();
+	bool reduce = pendingReduce[sid];
+	pendingReduce[sid] = false;
+	lock.unlock();
+	if (reduce) {
+		solvers[sid]->reduceMemory();
+	}
+}
+
+void MemoryGovernor::threadExited(int sid) {
+	lock.lock();
+	exited[sid] = true;
+	lock.unlock();
+}
+
+bool MemoryGovernor::isStopped(int sid) {
+	lock.lock();
+	bool result = stopped[sid];
+	lock.unlock();
+	return result;
+}
@@ -0,0 +1,102 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * MemoryGovernor.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#ifndef MEMORYGOVERNOR_H_
+#define MEMORYGOVERNOR_H_
+
+#include <vector>
+#include "Threading.h"
+#include "../solvers/PortfolioSolverInterface.h"
+#include "../sharing/SharingManagerInterface.h"
+
+using namespace std;
+
+// above this part of the budget the solvers reduce their clause databases
+// and the sharing buffers are shrunk
+#define MEM_REDUCE_RATIO 0.8
+// above this part of the budget the weakest solver is stopped
+#define MEM_STOP_RATIO 0.95
+// rounds to wait for the effect of an action before the next one
+#define MEM_ACTION_DELAY 5
+// an exported clause with glue 0 is worth this many conflicts when looking for the weakest solver
+#define MEM_EXPORT_WEIGHT 10.0
+
+/**
+ * Keeps the resident memory of the process under a budget. Every round the
+ * main thread compares the memory with the budget. Close to the budget the
+ * solvers are asked to reduce their learned clause databases and the sharing
+ * buffers are shrunk, at the budget the weakest solver (fewest conflicts and
+ * exported clauses) is stopped. The last running solver is never stopped.
+ * When the thread of a stopped solver has exited the solver is deleted and
+ * its entry in the solvers vector (shared with the caller) is set to NULL.
+ */
+class MemoryGovernor {
+public:
+	/**
+	 * The budget is in MB, only the stoppable solvers can be stopped
+	 * (the cube workers cannot, their cube would be lost) and only the
+	 * reducible ones are asked to reduce their memory (for the others
+	 * reduceMemory does nothing, the interrupt would only cost search).
+	 * The solvers vector is kept by reference.
+	 */
+	MemoryGovernor(vector<PortfolioSolverInterface*>& solvers, const vector<bool>& stoppable,
+			const vector<bool>& reducible, SharingManagerInterface* sharing, double budget, int rank);
+	/**
+	 * Check the memory and act if needed. Called by the main thread every round.
+	 */
+	void check(int round);
+	/**
+	 * Reduce the memory of the solver if it was asked to, called by the
+	 * solver thread before it starts solving.
+	 */
+	void applyPending(int sid);
+	bool isStopped(int sid);
+	/**
+	 * Called by the thread of a stopped solver as the last thing it does,
+	 * the solver is deleted in the next check.
+	 */
+	void threadExited(int sid);
+
+	int getReductions() {
+		return reductions;
+	}
+	int getStoppedCount() {
+		return stoppedCount;
+	}
+	double getPeakMemory() {
+		return peakMemory;
+	}
+	/**
+	 * Resident memory of the process in MB, 0 if it cannot be read.
+	 */
+	static double getResidentMemory();
+
+private:
+	vector<PortfolioSolverInterface*>& solvers;
+	vector<bool> stoppable;
+	vector<bool> reducible;
+	SharingManagerInterface* sharing;
+	double budget;
+	int rank;
+
+	Mutex lock;
+	vector<bool> pendingReduce;
+	vector<bool> stopped;
+	vector<bool> exited;
+
+	int nextActionRound;
+	int reductions;
+	int stoppedCount;
+	double peakMemory;
+
+	void releaseExited();
+	void reduce(double memory);
+	void stopWeakest(double memory);
+};
+
+#endif /* MEMORYGOVERNOR_H_ */
@@ -0,0 +1,31 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * PhaseBuffer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#include "PhaseBuffer.h"
+
+PhaseBuffer::PhaseBuffer():pending(false) {
+}
+
+void PhaseBuffer::set(const vector<int>& phases) {
+	lock.lock();
+	this->phases = phases;
+	pending = true;
+	lock.unlock();
+}
+
+bool PhaseBuffer::fetch(vector<int>& phases) {
+	if (!pending) {
+		return false;
+	}
+	lock.lock();
+	phases.swap(this->phases);
+	this->phases.clear();
+	pending = false;
+	lock.unlock();
+	return true;
+}
@@ -0,0 +1,44 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * PhaseBuffer.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#ifndef PHASEBUFFER_H_
+#define PHASEBUFFER_H_
+
+#include <vector>
+#include <atomic>
+#include "Threading.h"
+
+using namespace std;
+
+/**
+ * Phases (signed literals) given to a running solver by another thread.
+ * The solver takes them at its next import point, newer phases replace
+ * the ones it has not taken yet. The solver only takes the lock if there
+ * are new phases.
+ */
+class PhaseBuffer {
+public:
+	PhaseBuffer();
+
+	/**
+	 * Replace the phases not taken yet, can be called from any thread.
+	 */
+	void set(const vector<int>& phases);
+	/**
+	 * Move the new phases into the vector, called by the solver thread.
+	 * Return false if there are no new phases.
+	 */
+	bool fetch(vector<int>& phases);
+
+private:
+	Mutex lock;
+	vector<int> phases;
+	atomic<bool> pending;
+};
+
+#endif /* PHASEBUFFER_H_ */
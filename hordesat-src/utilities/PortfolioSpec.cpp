@@ -0,0 +1,91 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * PortfolioSpec.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#include "PortfolioSpec.h"
+#include "Logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sstream>
+
+static bool parseInt(const string& str, int& value) {
+	char* end;
+	value = strtol(str.c_str(), &end, 10);
+	return !str.empty() && *end == 0;
+}
+
+bool PortfolioSpec::parse(const string& text) {
+	slots.clear();
+	istringstream lines(text);
+	string line;
+	int lineNum = 0;
+	while (getline(lines, line)) {
+		lineNum++;
+		size_t hash = line.find('#');
+		if (hash != string::npos) {
+			line.erase(hash);
+		}
+		istringstream tokens(line);
+		string token;
+		SlotConfig slot;
+		int count = 1;
+		bool empty = true;
+		while (tokens >> token) {
+			empty = false;
+			size_t eq = token.find('=');
+			if (eq == string::npos) {
+				log(0, "portfolio line %d: expected key=value, got '%s'\n", lineNum, token.c_str());
+				return false;
+			}
+			string key = token.substr(0, eq);
+			string value = token.substr(eq+1);
+			if (key == "solver") {
+				slot.solver = value;
+				continue;
+			}
+			int num;
+			if (!parseInt(value, num)) {
+				log(0, "portfolio line %d: '%s' is not an integer\n", lineNum, value.c_str());
+				return false;
+			}
+			if (key == "seed") {
+				slot.seed = num;
+			} else if (key == "diversify") {
+				slot.diversify = num;
+			} else if (key == "production") {
+				slot.production = num;
+			} else if (key == "count") {
+				count = num;
+			} else {
+				slot.options.push_back(make_pair(key, num));
+			}
+		}
+		if (empty) {
+			continue;
+		}
+		if (slot.solver.empty() || count < 1) {
+			log(0, "portfolio line %d: missing solver or invalid count\n", lineNum);
+			return false;
+		}
+		slots.insert(slots.end(), count, slot);
+	}
+	return !slots.empty();
+}
+
+bool readTextFile(const char* filename, string& text) {
+	FILE* f = fopen(filename, "r");
+	if (f == NULL) {
+		return false;
+	}
+	char buf[4096];
+	size_t len;
+	while ((len = fread(buf, 1, sizeof(buf), f)) > 0) {
+		text.append(buf, len);
+	}
+	fclose(f);
+	return true;
+}
@@ -0,0 +1,61 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * PortfolioSpec.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#ifndef PORTFOLIOSPEC_H_
+#define PORTFOLIOSPEC_H_
+
+#include <vector>
+#include <string>
+using namespace std;
+
+#define SPEC_NOT_SET -1
+
+/**
+ * The configuration of one solver slot of the portfolio.
+ */
+struct SlotConfig {
+	SlotConfig():seed(SPEC_NOT_SET),diversify(SPEC_NOT_SET),production(0) {}
+	string solver;
+	int seed;
+	// rank for the native diversification of the solver
+	int diversify;
+	// how many times increaseClauseProduction is called at the start
+	int production;
+	// solver specific options
+	vector<pair<string, int> > options;
+};
+
+/**
+ * Portfolio description, one slot per line, for example:
+ *
+ *   # two lingelings with different native settings and a minisat
+ *   solver=lingeling diversify=6 count=2
+ *   solver=minisat seed=7 production=1 luby=0
+ *
+ * The known keys are solver, seed, diversify, production and count (repeat
+ * the line), any other key=value pair is passed to the solver as an option.
+ * The global slot (rank * cores + thread) uses the line slot % size().
+ */
+class PortfolioSpec {
+private:
+	vector<SlotConfig> slots;
+public:
+	// Parse the description, return false if it is invalid
+	bool parse(const string& text);
+	size_t size() const {
+		return slots.size();
+	}
+	const SlotConfig& getSlot(int globalSlot) const {
+		return slots[globalSlot % slots.size()];
+	}
+};
+
+// Read the whole file into text, return false if failed
+bool readTextFile(const char* filename, string& text);
+
+#endif /* PORTFOLIOSPEC_H_ */
@@ -0,0 +1,110 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * ProgressReporter.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#include "ProgressReporter.h"
+#include "Logger.h"
+#include <stdio.h>
+
+struct Metric {
+	const char* name;
+	const char* type;
+	const char* help;
+};
+
+// in the order of the values filled by collect
+static const Metric metrics[PROGRESS_VALUES] = {
+	{"hordesat_conflicts", "counter", "Conflicts of all the solvers of the rank."},
+	{"hordesat_decisions", "counter", "Decisions of all the solvers of the rank."},
+	{"hordesat_propagations", "counter", "Propagations of all the solvers of the rank."},
+	{"hordesat_shared_clauses", "counter", "Learned clauses sent by the rank."},
+	{"hordesat_imported_clauses", "counter", "Received clauses that passed the filter."},
+	{"hordesat_filtered_clauses", "counter", "Duplicate clauses removed by the filter."},
+	{"hordesat_exchange_seconds", "counter", "Time spent in the clause exchange."},
+	{"hordesat_memory_peak_megabytes", "gauge", "Peak memory of all the solvers of the rank."},
+};
+
+ProgressReporter::ProgressReporter(const string& filename, int mpi_rank, int mpi_size,
+		vector<PortfolioSolverInterface*>& solvers, SharingManagerInterface* sharing)
+	:filename(filename),mpi_rank(mpi_rank),mpi_size(mpi_size),solvers(solvers),sharing(sharing),
+	 requestPending(false),gatheredRound(0) {
+	sendBuffer.resize(PROGRESS_VALUES);
+	if (mpi_rank == 0) {
+		receiveBuffer.resize(PROGRESS_VALUES * mpi_size);
+	}
+}
+
+void ProgressReporter::collect(double* values) {
+	for (int i = 0; i < PROGRESS_VALUES; i++) {
+		values[i] = 0;
+	}
+	for (size_t sid = 0; sid < solvers.size(); sid++) {
+		if (solvers[sid] == NULL) {
+			continue;
+		}
+		SolvingStatistics st = solvers[sid]->getStatistics();
+		values[0] += st.conflicts;
+		values[1] += st.decisions;
+		values[2] += st.propagations;
+		values[7] += st.memPeak;
+	}
+	if (sharing != NULL) {
+		SharingStatistics sh = sharing->getStatistics();
+		values[3] = sh.sharedClauses;
+		values[4] = sh.importedClauses;
+		values[5] = sh.filteredClauses;
+		values[6] = sh.exchangeTime;
+	}
+}
+
+void ProgressReporter::report(int round) {
+	if (round % PROGRESS_ROUNDS != 0) {
+		return;
+	}
+	// the gather of the previous snapshot had PROGRESS_ROUNDS rounds to finish
+	if (requestPending) {
+		MPI_Wait(&request, MPI_STATUS_IGNORE);
+		requestPending = false;
+		if (mpi_rank == 0) {
+			write(gatheredRound);
+		}
+	}
+	collect(sendBuffer.data());
+	MPI_Igather(sendBuffer.data(), PROGRESS_VALUES, MPI_DOUBLE, receiveBuffer.data(), PROGRESS_VALUES,
+			MPI_DOUBLE, 0, MPI_COMM_WORLD, &request);
+	requestPending = true;
+	gatheredRound = round;
+}
+
+ProgressReporter::~ProgressReporter() {
+	if (requestPending) {
+		MPI_Wait(&request, MPI_STATUS_IGNORE);
+	}
+}
+
+void ProgressReporter::write(int round) {
+	string tmpName = filename + ".tmp";
+	FILE* f = fopen(tmpName.c_str(), "w");
+	if (f == NULL) {
+		log(0, "cannot write the progress file %s\n", tmpName.c_str());
+		return;
+	}
+	fprintf(f, "# HELP hordesat_ranks Number of MPI ranks.\n# TYPE hordesat_ranks gauge\nhordesat_ranks %d\n", mpi_size);
+	fprintf(f, "# HELP hordesat_rounds Completed rounds.\n# TYPE hordesat_rounds counter\nhordesat_rounds %d\n", round);
+	fprintf(f, "# HELP hordesat_time_seconds Time since the start.\n# TYPE hordesat_time_seconds gauge\n"
+			"hordesat_time_seconds %.3f\n", getTime());
+	for (int i = 0; i < PROGRESS_VALUES; i++) {
+		fprintf(f, "# HELP %s %s\n# TYPE %s %s\n", metrics[i].name, metrics[i].help, metrics[i].name, metrics[i].type);
+		for (int r = 0; r < mpi_size; r++) {
+			fprintf(f, "%s{rank=\"%d\"} %.17g\n", metrics[i].name, r, receiveBuffer[r * PROGRESS_VALUES + i]);
+		}
+	}
+	fclose(f);
+	if (rename(tmpName.c_str(), filename.c_str()) != 0) {
+		log(0, "cannot rename the progress file to %s\n", filename.c_str());
+	}
+}
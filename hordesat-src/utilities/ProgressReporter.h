@@ -0,0 +1,61 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * ProgressReporter.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#ifndef PROGRESSREPORTER_H_
+#define PROGRESSREPORTER_H_
+
+#include <mpi.h>
+#include <string>
+#include <vector>
+#include "../solvers/PortfolioSolverInterface.h"
+#include "../sharing/SharingManagerInterface.h"
+
+using namespace std;
+
+// rounds between two snapshots, counted in the same way by all the ranks
+// since the values are gathered by a collective
+#define PROGRESS_ROUNDS 5
+// the values each rank sends, see ProgressReporter::collect
+#define PROGRESS_VALUES 8
+
+/**
+ * Live progress of a running job. Every PROGRESS_ROUNDS rounds each rank
+ * sends a few values to rank 0 with a non-blocking gather, which is
+ * completed at the next snapshot, so nobody waits for it. Rank 0 rewrites a
+ * snapshot file in the Prometheus text format with the values of all the
+ * ranks. The file is written to a temporary file and renamed, so a reader
+ * never sees a partial snapshot.
+ */
+class ProgressReporter {
+public:
+	ProgressReporter(const string& filename, int mpi_rank, int mpi_size,
+			vector<PortfolioSolverInterface*>& solvers, SharingManagerInterface* sharing);
+	/**
+	 * Called by all the ranks after the ending detection of each round.
+	 */
+	void report(int round);
+	~ProgressReporter();
+
+private:
+	string filename;
+	int mpi_rank, mpi_size;
+	// the solvers released by the memory governor are NULL
+	vector<PortfolioSolverInterface*>& solvers;
+	SharingManagerInterface* sharing;
+	vector<double> sendBuffer;
+	vector<double> receiveBuffer;
+	MPI_Request request;
+	bool requestPending;
+	// the round of the values in the receive buffer
+	int gatheredRound;
+
+	void collect(double* values);
+	void write(int round);
+};
+
+#endif /* PROGRESSREPORTER_H_ */
@@ -0,0 +1,116 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * RootAssignment.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#include "RootAssignment.h"
+#include <stdlib.h>
+
+RootAssignment::RootAssignment():unitsCount(0),satisfiedCount(0),strippedLiteralsCount(0),knownUnitsCount(0) {
+}
+
+void RootAssignment::addUnitUnlocked(int lit) {
+	size_t var = abs(lit);
+	if (values.size() <= var) {
+		values.resize(2*var, 0);
+	}
+	if (values[var] == 0) {
+		values[var] = lit > 0 ? 1 : -1;
+		newUnits.push_back(lit);
+		unitsCount++;
+	}
+}
+
+int RootAssignment::valueUnlocked(int lit) {
+	size_t var = abs(lit);
+	if (var >= values.size()) {
+		return 0;
+	}
+	return lit > 0 ? values[var] : -values[var];
+}
+
+int RootAssignment::addUnit(int lit) {
+	lock.lock();
+	int val = valueUnlocked(lit);
+	if (val > 0) {
+		knownUnitsCount++;
+	} else {
+		addUnitUnlocked(lit);
+	}
+	lock.unlock();
+	return val;
+}
+
+int RootAssignment::value(int lit) {
+	lock.lock();
+	int val = valueUnlocked(lit);
+	lock.unlock();
+	return val;
+}
+
+int RootAssignment::simplifyClauses(vector<vector<int> >& clauses) {
+	lock.lock();
+	size_t kept = 0;
+	int satisfied = 0;
+	for (size_t cid = 0; cid < clauses.size(); cid++) {
+		vector<int>& cls = clauses[cid];
+		if (cls.size() == 1) {
+			int val = valueUnlocked(cls[0]);
+			if (val > 0) {
+				knownUnitsCount++;
+				continue;
+			}
+			// new units are given to the solvers together with the locally learned ones
+			if (val == 0) {
+				addUnitUnlocked(cls[0]);
+				continue;
+			}
+			// a contradicting unit is kept, the solvers derive the empty clause from it
+		} else {
+			// skip the first int (it is the glue)
+			bool sat = false;
+			size_t top = 1;
+			for (size_t i = 1; i < cls.size(); i++) {
+				int val = valueUnlocked(cls[i]);
+				if (val > 0) {
+					sat = true;
+					break;
+				}
+				if (val == 0) {
+					cls[top++] = cls[i];
+				}
+			}
+			if (sat) {
+				satisfied++;
+				continue;
+			}
+			if (top == 2) {
+				strippedLiteralsCount += cls.size() - top;
+				addUnitUnlocked(cls[1]);
+				continue;
+			}
+			// if all the literals are false the clause is kept as it is
+			// and the solvers will detect the conflict
+			if (top > 2) {
+				strippedLiteralsCount += cls.size() - top;
+				cls.resize(top);
+			}
+		}
+		if (kept != cid) {
+			clauses[kept].swap(cls);
+		}
+		kept++;
+	}
+	clauses.resize(kept);
+	// every unit used for the simplification must reach all the solvers
+	for (size_t i = 0; i < newUnits.size(); i++) {
+		clauses.push_back(vector<int>(1, newUnits[i]));
+	}
+	newUnits.clear();
+	satisfiedCount += satisfied;
+	lock.unlock();
+	return satisfied;
+}
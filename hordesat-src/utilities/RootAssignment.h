@@ -0,0 +1,79 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * RootAssignment.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#ifndef ROOTASSIGNMENT_H_
+#define ROOTASSIGNMENT_H_
+
+#include <vector>
+#include "Threading.h"
+
+using namespace std;
+
+/**
+ * Node level cache of the literals known to be true at decision level 0.
+ * It is fed by the unit clauses learned by the local solvers and received
+ * from the other nodes and used to simplify the incoming clauses before
+ * they are given to the solvers.
+ */
+class RootAssignment {
+public:
+	RootAssignment();
+
+	/**
+	 * Register a literal that is implied by the formula. Return the value
+	 * the literal had before (see value), a unit that was already known
+	 * is counted (see getKnownUnitsCount).
+	 */
+	int addUnit(int lit);
+	/**
+	 * Return 1 if the literal is true, -1 if it is false and 0 if unknown.
+	 */
+	int value(int lit);
+	/**
+	 * Simplify the given shared clauses (the first int of the non-unit clauses
+	 * is the glue). Satisfied clauses are removed from the vector, false literals
+	 * are removed from the clauses. Clauses reduced to a single literal
+	 * are registered as units. All the units registered since the last call
+	 * are appended to the vector as unit clauses. A unit contradicting
+	 * the known ones is kept, it proves that the formula is unsatisfiable
+	 * and the solvers derive the empty clause from it.
+	 * Return the number of removed satisfied clauses, the removed units that
+	 * were already known are not counted (see getKnownUnitsCount).
+	 */
+	int simplifyClauses(vector<vector<int> >& clauses);
+
+	unsigned long getSatisfiedCount() {
+		return satisfiedCount;
+	}
+	unsigned long getStrippedLiteralsCount() {
+		return strippedLiteralsCount;
+	}
+	unsigned long getKnownUnitsCount() {
+		return knownUnitsCount;
+	}
+	size_t getUnitsCount() {
+		return unitsCount;
+	}
+
+private:
+	Mutex lock;
+	// indexed by variable: 1 true, -1 false, 0 unknown
+	vector<signed char> values;
+	// units not yet given to the solvers
+	vector<int> newUnits;
+	size_t unitsCount;
+	unsigned long satisfiedCount;
+	unsigned long strippedLiteralsCount;
+	// incoming units that were already known
+	unsigned long knownUnitsCount;
+
+	void addUnitUnlocked(int lit);
+	int valueUnlocked(int lit);
+};
+
+#endif /* ROOTASSIGNMENT_H_ */
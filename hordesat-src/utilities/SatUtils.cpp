@@ -11,13 +11,23 @@
 #include <stdio.h>
 
 bool loadFormulaToSolvers(vector<PortfolioSolverInterface*> solvers, const char* filename) {
+	vector<vector<int> > clauses;
+	if (!readFormula(filename, clauses)) {
+		return false;
+	}
+	for (size_t i = 0; i < solvers.size(); i++) {
+		solvers[i]->addInitialClauses(clauses);
+	}
+	return true;
+}
+
+bool readFormula(const char* filename, vector<vector<int> >& clauses) {
 	FILE* f = fopen(filename, "r");
 	if (f == NULL) {
 		return false;
 	}
 	int c = 0;
 	bool neg = false;
-	vector<vector<int> > clauses;
 	vector<int> cls;
 	while (c != EOF) {
 		c = fgetc(f);
@@ -62,11 +72,6 @@ bool loadFormulaToSolvers(vector<PortfolioSolverInterface*> solvers, const char*
 		}
 	}
 	fclose(f);
-
-	for (size_t i = 0; i < solvers.size(); i++) {
-		solvers[i]->addInitialClauses(clauses);
-	}
-
 	return true;
 }
 
@@ -12,5 +12,6 @@
 #include "../solvers/PortfolioSolverInterface.h"
 
 bool loadFormulaToSolvers(vector<PortfolioSolverInterface*> solvers, const char* filename);
+bool readFormula(const char* filename, vector<vector<int> >& clauses);
 
 #endif /* SATUTILS_H_ */
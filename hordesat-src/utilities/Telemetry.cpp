@@ -0,0 +1,72 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * Telemetry.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#include "Telemetry.h"
+#include "Logger.h"
+
+Telemetry::Telemetry(const string& prefix, int rank, int solvers)
+	:buffer(NULL),rank(rank),lastTime(0),lastFlush(0),lastSolving(solvers),lastExport(solvers) {
+	char filename[1024];
+	snprintf(filename, sizeof(filename), "%s.%d.jsonl", prefix.c_str(), rank);
+	file = fopen(filename, "w");
+	if (file == NULL) {
+		log(0, "cannot open the telemetry file %s\n", filename);
+		return;
+	}
+	buffer = new char[TELEMETRY_BUFFER_SIZE];
+	setvbuf(file, buffer, _IOFBF, TELEMETRY_BUFFER_SIZE);
+}
+
+void Telemetry::recordRound(int round, double time, double endingTime, vector<PortfolioSolverInterface*>& solvers,
+		SharingManagerInterface* sharing) {
+	if (file == NULL) {
+		return;
+	}
+	double elapsed = time - lastTime;
+	lastTime = time;
+	unsigned long produced = 0;
+	SharingStatistics sh;
+	if (sharing != NULL) {
+		sh = sharing->getStatistics();
+		for (size_t sid = 0; sid < solvers.size(); sid++) {
+			SolverExportStatistics ex = sharing->getSolverStatistics(sid);
+			produced += ex.exportedClauses + ex.duplicateClauses
+					- lastExport[sid].exportedClauses - lastExport[sid].duplicateClauses;
+			lastExport[sid] = ex;
+		}
+	}
+	unsigned long selected = sh.sharedClauses - lastSharing.sharedClauses;
+	unsigned long vip = sh.vipClauses - lastSharing.vipClauses;
+	fprintf(file, "{\"time\":%.3f,\"rank\":%d,\"round\":%d,\"produced\":%lu,\"selected\":%lu,\"sent\":%lu,"
+			"\"received\":%lu,\"filtered\":%lu,\"imported\":%lu,\"dropped\":%lu,\"fill\":%d,"
+			"\"exchange\":%.6f,\"ending\":%.6f,\"cps\":[",
+			time, rank, round, produced, selected, selected + vip,
+			sh.receivedClauses - lastSharing.receivedClauses, sh.filteredClauses - lastSharing.filteredClauses,
+			sh.importedClauses - lastSharing.importedClauses, sh.dropped - lastSharing.dropped, sh.bufferFill,
+			sh.exchangeTime - lastSharing.exchangeTime, endingTime);
+	lastSharing = sh;
+	for (size_t sid = 0; sid < solvers.size(); sid++) {
+		// a solver released by the memory governor keeps its last statistics
+		SolvingStatistics st = solvers[sid] != NULL ? solvers[sid]->getStatistics() : lastSolving[sid];
+		double cps = elapsed > 0 ? (st.conflicts - lastSolving[sid].conflicts) / elapsed : 0;
+		fprintf(file, sid == 0 ? "%.0f" : ",%.0f", cps);
+		lastSolving[sid] = st;
+	}
+	fprintf(file, "]}\n");
+	if (time - lastFlush >= TELEMETRY_FLUSH_INTERVAL) {
+		fflush(file);
+		lastFlush = time;
+	}
+}
+
+Telemetry::~Telemetry() {
+	if (file != NULL) {
+		fclose(file);
+	}
+	delete[] buffer;
+}
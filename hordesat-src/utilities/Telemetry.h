@@ -0,0 +1,59 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * Telemetry.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "../solvers/PortfolioSolverInterface.h"
+#include "../sharing/SharingManagerInterface.h"
+
+using namespace std;
+
+// the records are written from this buffer, not after each round
+#define TELEMETRY_BUFFER_SIZE (1 << 20)
+// seconds between two flushes of the buffer, a killed run loses at most this much
+#define TELEMETRY_FLUSH_INTERVAL 10
+
+/**
+ * Writes one JSON line per round into the file <prefix>.<rank>.jsonl with
+ * what happened since the previous round: the clauses produced by the
+ * solvers, selected and sent by the node, received, filtered and imported,
+ * the send buffer fill, the time spent in the clause exchange and in the
+ * ending detection and the conflicts per second of each solver. The time
+ * is the first field, so the files of all the ranks can be merged into a
+ * timeline by sorting (see plotting-scripts/mergeTelemetry.sh).
+ */
+class Telemetry {
+public:
+	Telemetry(const string& prefix, int rank, int solvers);
+	bool isOpen() {
+		return file != NULL;
+	}
+	/**
+	 * Called by the main thread at the end of each round, the sharing
+	 * manager can be NULL.
+	 */
+	void recordRound(int round, double time, double endingTime, vector<PortfolioSolverInterface*>& solvers,
+			SharingManagerInterface* sharing);
+	~Telemetry();
+
+private:
+	FILE* file;
+	char* buffer;
+	int rank;
+	double lastTime;
+	double lastFlush;
+	vector<SolvingStatistics> lastSolving;
+	vector<SolverExportStatistics> lastExport;
+	SharingStatistics lastSharing;
+};
+
+#endif /* TELEMETRY_H_ */
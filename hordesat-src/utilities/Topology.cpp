@@ -0,0 +1,140 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * Topology.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#include "Topology.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sched.h>
+#include <algorithm>
+
+// Parse a list like "0-3,8-11,16" into the CPU (or node) numbers
+static bool readCpuList(const char* filename, vector<int>& cpus) {
+	FILE* f = fopen(filename, "r");
+	if (f == NULL) {
+		return false;
+	}
+	int first, last;
+	while (fscanf(f, "%d", &first) == 1) {
+		last = first;
+		int c = fgetc(f);
+		if (c == '-') {
+			if (fscanf(f, "%d", &last) != 1) {
+				break;
+			}
+			c = fgetc(f);
+		}
+		for (int cpu = first; cpu <= last; cpu++) {
+			cpus.push_back(cpu);
+		}
+		if (c != ',') {
+			break;
+		}
+	}
+	fclose(f);
+	return true;
+}
+
+// 0 for the first hardware thread of a core, 1 for its first sibling, ...
+static int siblingIndex(int cpu) {
+	char filename[256];
+	snprintf(filename, sizeof(filename), TOPOLOGY_SYS_CPUS "/cpu%d/topology/thread_siblings_list", cpu);
+	vector<int> siblings;
+	if (!readCpuList(filename, siblings)) {
+		return 0;
+	}
+	return find(siblings.begin(), siblings.end(), cpu) - siblings.begin();
+}
+
+Topology::Topology() {
+	onlineCpus = sysconf(_SC_NPROCESSORS_ONLN);
+	cpu_set_t allowed;
+	CPU_ZERO(&allowed);
+	if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+		for (int cpu = 0; cpu < onlineCpus; cpu++) {
+			CPU_SET(cpu, &allowed);
+		}
+	}
+	// the node numbers can have gaps
+	vector<int> nodeIds;
+	readCpuList(TOPOLOGY_SYS_NODES "/online", nodeIds);
+	for (size_t n = 0; n < nodeIds.size(); n++) {
+		char filename[256];
+		snprintf(filename, sizeof(filename), TOPOLOGY_SYS_NODES "/node%d/cpulist", nodeIds[n]);
+		vector<int> cpus;
+		if (!readCpuList(filename, cpus)) {
+			continue;
+		}
+		vector<pair<int, int> > usable;
+		for (size_t i = 0; i < cpus.size(); i++) {
+			if (cpus[i] < CPU_SETSIZE && CPU_ISSET(cpus[i], &allowed)) {
+				usable.push_back(make_pair(siblingIndex(cpus[i]), cpus[i]));
+			}
+		}
+		if (usable.empty()) {
+			continue;
+		}
+		sort(usable.begin(), usable.end());
+		nodes.push_back(vector<int>());
+		for (size_t i = 0; i < usable.size(); i++) {
+			nodes.back().push_back(usable[i].second);
+		}
+	}
+	if (nodes.empty()) {
+		nodes.push_back(vector<int>());
+		for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+			if (CPU_ISSET(cpu, &allowed)) {
+				nodes.back().push_back(cpu);
+			}
+		}
+	}
+	for (size_t node = 0; node < nodes.size(); node++) {
+		for (size_t i = 0; i < nodes[node].size(); i++) {
+			int cpu = nodes[node][i];
+			if ((int)nodeOfCpu.size() <= cpu) {
+				nodeOfCpu.resize(cpu + 1, 0);
+			}
+			nodeOfCpu[cpu] = node;
+		}
+	}
+}
+
+int Topology::getCpusCount() {
+	int count = 0;
+	for (size_t node = 0; node < nodes.size(); node++) {
+		count += nodes[node].size();
+	}
+	return count;
+}
+
+int Topology::getSolverCpu(int slot) {
+	int node = slot % nodes.size();
+	int index = slot / nodes.size();
+	// nodes with fewer CPUs wrap around earlier
+	return nodes[node][index % nodes[node].size()];
+}
+
+int Topology::getNode(int cpu) {
+	if (cpu < 0 || cpu >= (int)nodeOfCpu.size()) {
+		return 0;
+	}
+	return nodeOfCpu[cpu];
+}
+
+bool pinCurrentThread(int cpu) {
+	return pinCurrentThread(vector<int>(1, cpu));
+}
+
+bool pinCurrentThread(const vector<int>& cpus) {
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	for (size_t i = 0; i < cpus.size(); i++) {
+		CPU_SET(cpus[i], &cpuSet);
+	}
+	return sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == 0;
+}
@@ -0,0 +1,63 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * Topology.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#ifndef TOPOLOGY_H_
+#define TOPOLOGY_H_
+
+#include <vector>
+
+using namespace std;
+
+#define TOPOLOGY_SYS_NODES "/sys/devices/system/node"
+#define TOPOLOGY_SYS_CPUS "/sys/devices/system/cpu"
+
+/**
+ * The NUMA nodes of the machine and their CPUs, read from /sys and restricted
+ * to the CPUs this process may run on. Without NUMA information all CPUs are
+ * on node 0. Inside a node the first hardware thread of every core comes
+ * before the hyper-threading siblings.
+ */
+class Topology {
+private:
+	vector<vector<int> > nodes;
+	vector<int> nodeOfCpu;
+	int onlineCpus;
+
+public:
+	Topology();
+	int getNodesCount() {
+		return nodes.size();
+	}
+	int getCpusCount();
+	/**
+	 * True if the process may use only a part of the machine, this happens
+	 * when the MPI launcher already bound the rank to some cores.
+	 */
+	bool isRestricted() {
+		return getCpusCount() < onlineCpus;
+	}
+	/**
+	 * The CPU of a solver slot. Consecutive slots go to different NUMA nodes
+	 * so the solvers (and their memory bandwidth) are spread over the sockets,
+	 * slot i and slot i + getCpusCount() share a CPU.
+	 */
+	int getSolverCpu(int slot);
+	int getNode(int cpu);
+	const vector<int>& getNodeCpus(int node) {
+		return nodes[node];
+	}
+};
+
+/**
+ * Bind the calling thread to the given CPUs. Memory the thread touches first
+ * afterwards is allocated on the NUMA node of these CPUs.
+ */
+bool pinCurrentThread(int cpu);
+bool pinCurrentThread(const vector<int>& cpus);
+
+#endif /* TOPOLOGY_H_ */
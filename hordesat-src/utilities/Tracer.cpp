@@ -0,0 +1,87 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * Tracer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#include "Tracer.h"
+#include "Threading.h"
+#include <stdio.h>
+#include <vector>
+
+// The spans of one thread, written only by that thread
+struct TraceRing {
+	string threadName;
+	TraceEvent events[TRACE_RING_SIZE];
+	unsigned long count;
+};
+
+bool tracingEnabled = false;
+__thread unsigned long traceSampleCounter = 0;
+
+static Mutex ringsLock;
+static vector<TraceRing*> rings;
+static __thread TraceRing* threadRing = NULL;
+
+static TraceRing* getThreadRing() {
+	if (threadRing == NULL) {
+		threadRing = new TraceRing();
+		threadRing->count = 0;
+		ringsLock.lock();
+		char name[32];
+		snprintf(name, sizeof(name), "thread %lu", rings.size());
+		threadRing->threadName = name;
+		rings.push_back(threadRing);
+		ringsLock.unlock();
+	}
+	return threadRing;
+}
+
+void startTracing() {
+	tracingEnabled = true;
+}
+
+void setTraceThreadName(const char* name) {
+	if (tracingEnabled) {
+		getThreadRing()->threadName = name;
+	}
+}
+
+void addTraceEvent(const char* name, double start, double end) {
+	TraceRing* ring = getThreadRing();
+	TraceEvent& event = ring->events[ring->count % TRACE_RING_SIZE];
+	event.name = name;
+	event.start = start;
+	event.end = end;
+	ring->count++;
+}
+
+bool writeTrace(const char* filename, int rank) {
+	FILE* f = fopen(filename, "w");
+	if (f == NULL) {
+		log(0, "cannot open the trace file %s\n", filename);
+		return false;
+	}
+	fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"rank %d\"}}",
+			rank, rank);
+	ringsLock.lock();
+	for (size_t tid = 0; tid < rings.size(); tid++) {
+		TraceRing* ring = rings[tid];
+		fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%lu,\"args\":{\"name\":\"%s\"}}",
+				rank, tid, ring->threadName.c_str());
+		unsigned long first = ring->count > TRACE_RING_SIZE ? ring->count - TRACE_RING_SIZE : 0;
+		for (unsigned long i = first; i < ring->count; i++) {
+			TraceEvent& event = ring->events[i % TRACE_RING_SIZE];
+			// the times are in microseconds
+			fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%lu,\"ts\":%.1f,\"dur\":%.1f}",
+					event.name, rank, tid, event.start * 1000000, (event.end - event.start) * 1000000);
+		}
+	}
+	ringsLock.unlock();
+	fprintf(f, "\n]}\n");
+	fclose(f);
+	return true;
+}
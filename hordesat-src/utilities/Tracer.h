@@ -0,0 +1,116 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * Tracer.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#ifndef TRACER_H_
+#define TRACER_H_
+
+#include <string>
+#include <stddef.h>
+#include "Logger.h"
+
+using namespace std;
+
+// the last this many spans of each thread are kept
+#define TRACE_RING_SIZE (1 << 16)
+// one of this many spans around single clauses is measured
+#define TRACE_SAMPLE_RATE 64
+
+struct TraceEvent {
+	const char* name;
+	double start;
+	double end;
+};
+
+extern bool tracingEnabled;
+// counts the sampled spans of the calling thread
+extern __thread unsigned long traceSampleCounter;
+
+/**
+ * Start recording the spans, the names are not copied, they have to be
+ * string literals.
+ */
+void startTracing();
+/**
+ * Name of the calling thread in the trace.
+ */
+void setTraceThreadName(const char* name);
+/**
+ * Record a span of the calling thread. Each thread writes into its own
+ * ring, there is no locking except when a thread records its first span.
+ */
+void addTraceEvent(const char* name, double start, double end);
+/**
+ * Write the spans of all the threads as a Chrome trace event file (can be
+ * opened in Perfetto or chrome://tracing), the rank is the process id.
+ * Called at the end, when the other threads do not record any more.
+ */
+bool writeTrace(const char* filename, int rank);
+
+/**
+ * Records the time between its construction and destruction, and adds it
+ * to the total if one is given (also when not tracing).
+ */
+class TraceSpan {
+private:
+	const char* name;
+	double* total;
+	bool active;
+	double start;
+public:
+	TraceSpan(const char* name, double* total = NULL):name(name),total(total),active(tracingEnabled),start(0) {
+		if (active || total != NULL) {
+			start = getTime();
+		}
+	}
+	~TraceSpan() {
+		if (active || total != NULL) {
+			double end = getTime();
+			if (total != NULL) {
+				*total += end - start;
+			}
+			if (active) {
+				addTraceEvent(name, start, end);
+			}
+		}
+	}
+};
+
+/**
+ * For the spans around a single learned clause, there are too many of them
+ * to record each one (the ring would only hold the last few seconds) or to
+ * call getTime twice for each. Only every TRACE_SAMPLE_RATE-th span of the
+ * thread is measured and recorded, the total gets its duration times the
+ * rate, so it is an estimate.
+ */
+class SampledTraceSpan {
+private:
+	const char* name;
+	double* total;
+	bool sampled;
+	double start;
+public:
+	SampledTraceSpan(const char* name, double* total = NULL):name(name),total(total),sampled(false),start(0) {
+		if ((tracingEnabled || total != NULL) && traceSampleCounter++ % TRACE_SAMPLE_RATE == 0) {
+			sampled = true;
+			start = getTime();
+		}
+	}
+	~SampledTraceSpan() {
+		if (sampled) {
+			double end = getTime();
+			if (total != NULL) {
+				*total += TRACE_SAMPLE_RATE * (end - start);
+			}
+			if (tracingEnabled) {
+				addTraceEvent(name, start, end);
+			}
+		}
+	}
+};
+
+#endif /* TRACER_H_ */
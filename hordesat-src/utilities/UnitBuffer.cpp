@@ -0,0 +1,82 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * UnitBuffer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#include "UnitBuffer.h"
+#include <stdlib.h>
+
+// position of a literal in the bit vectors
+#define LIT_INDEX(lit) (2*(size_t)abs(lit) + (lit < 0 ? 1 : 0))
+
+UnitBuffer::UnitBuffer():duplicateCount(0),headPos(0),importedCount(0),knownCount(0) {
+	head = tail = new UnitChunk();
+}
+
+bool UnitBuffer::add(int lit) {
+	size_t index = LIT_INDEX(lit);
+	if (index >= added.size()) {
+		added.resize(2*index, false);
+	}
+	if (added[index]) {
+		duplicateCount++;
+		return false;
+	}
+	added[index] = true;
+	int count = tail->count.load(memory_order_relaxed);
+	if (count == UNIT_CHUNK_SIZE) {
+		UnitChunk* chunk = new UnitChunk();
+		tail->next.store(chunk, memory_order_release);
+		tail = chunk;
+		count = 0;
+	}
+	tail->lits[count] = lit;
+	tail->count.store(count+1, memory_order_release);
+	return true;
+}
+
+void UnitBuffer::markKnown(int lit) {
+	size_t index = LIT_INDEX(lit);
+	if (index >= known.size()) {
+		known.resize(2*index, false);
+	}
+	known[index] = true;
+}
+
+size_t UnitBuffer::fetch(vector<int>& units) {
+	units.clear();
+	while (true) {
+		int count = head->count.load(memory_order_acquire);
+		for (; headPos < count; headPos++) {
+			int lit = head->lits[headPos];
+			size_t index = LIT_INDEX(lit);
+			if (index < known.size() && known[index]) {
+				knownCount++;
+				continue;
+			}
+			markKnown(lit);
+			units.push_back(lit);
+		}
+		UnitChunk* next = head->next.load(memory_order_acquire);
+		if (headPos < UNIT_CHUNK_SIZE || next == NULL) {
+			break;
+		}
+		// the producer has moved on, the chunk can be released
+		delete head;
+		head = next;
+		headPos = 0;
+	}
+	importedCount += units.size();
+	return units.size();
+}
+
+UnitBuffer::~UnitBuffer() {
+	while (head != NULL) {
+		UnitChunk* next = head->next.load();
+		delete head;
+		head = next;
+	}
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2015 Tomas Balyo, Karlsruhe Institute of Technology
+/*
+ * UnitBuffer.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#ifndef UNITBUFFER_H_
+#define UNITBUFFER_H_
+
+#include <stddef.h>
+#include <vector>
+#include <atomic>
+
+using namespace std;
+
+#define UNIT_CHUNK_SIZE 1024
+
+struct UnitChunk {
+	int lits[UNIT_CHUNK_SIZE];
+	atomic<int> count;
+	atomic<UnitChunk*> next;
+	UnitChunk():count(0),next(NULL) {}
+};
+
+/**
+ * Lock-free channel of unit clauses from the sharing thread (the only producer)
+ * to a solver thread (the only consumer). Each literal passes the channel
+ * at most once and every unit is consumed exactly once. Literals that the
+ * solver already knows (because it produced them) are not given back to it.
+ */
+class UnitBuffer {
+public:
+	UnitBuffer();
+	virtual ~UnitBuffer();
+
+	/**
+	 * Add a unit, called by the producer. Return false if the literal
+	 * has already been added before.
+	 */
+	bool add(int lit);
+	/**
+	 * Remember that the solver already knows the literal, called by the consumer.
+	 */
+	void markKnown(int lit);
+	/**
+	 * Replace the content of units with the units added since the last call
+	 * which are not known to the solver, called by the consumer.
+	 * Return the number of units.
+	 */
+	size_t fetch(vector<int>& units);
+
+	// the number of units given to the solver
+	unsigned long getImportedCount() {
+		return importedCount;
+	}
+	// the number of units dropped as duplicates or known to the solver
+	unsigned long getKnownCount() {
+		return duplicateCount + knownCount;
+	}
+
+private:
+	// producer side
+	UnitChunk* tail;
+	vector<bool> added;
+	unsigned long duplicateCount;
+	// consumer side
+	UnitChunk* head;
+	int headPos;
+	vector<bool> known;
+	unsigned long importedCount;
+	unsigned long knownCount;
+};
+
+#endif /* UNITBUFFER_H_ */
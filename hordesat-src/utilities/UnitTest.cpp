@@ -7,10 +7,30 @@
  */
 
 #include "ClauseDatabase.h"
+#include "ImportBuffer.h"
+#include "ClausePool.h"
+#include "Logger.h"
 #include <stdarg.h>
 #include "DebugUtils.h"
 #include <algorithm>
 #include <string.h>
+#include <new>
+
+// counts the heap allocations for allocationBenchmark
+static unsigned long allocations = 0;
+
+void* operator new(size_t size) {
+	allocations++;
+	void* p = malloc(size);
+	if (p == NULL) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void operator delete(void* p) noexcept {
+	free(p);
+}
 
 vector<int> makecls(int l) {
 	vector<int> vec;
@@ -86,12 +106,17 @@ void testClauseDatabaseManual() {
 	cdb3.giveSelection(buffer, size);
 	cdb1.giveSelection(buffer+size, size);
 	cdb2.giveSelection(buffer+2*size, size);
+	vector<int> vipBuffer;
+	cdb3.giveVIPSelection(vipBuffer);
+	cdb1.giveVIPSelection(vipBuffer);
+	cdb2.giveVIPSelection(vipBuffer);
 
 	printArray(buffer, size);
 	printArray(buffer+size, size);
 	printArray(buffer+2*size, size);
 
 	cdb1.setIncomingBuffer(buffer, size, nodes, 1);
+	cdb1.setIncomingVIPBuffer(vipBuffer.data(), vipBuffer.size());
 
 	vector<int> c;
 	while (cdb1.getNextIncomingClause(c)) {
@@ -113,6 +138,7 @@ void testClauseDatabaseRandom(int tests) {
 		vector<vector<int> > clss;
 		ClauseDatabase* dbs = new ClauseDatabase[nodes];
 		int* buffer = new int[nodes*size];
+		vector<int> vipBuffer;
 		for (int node = 0; node < nodes; node++) {
 			int vipc = rand() % 4;
 			for (int j = 0; j < vipc; j++) {
@@ -129,10 +155,12 @@ void testClauseDatabaseRandom(int tests) {
 				clss.push_back(cls);
 			}
 			dbs[node].giveSelection(buffer + node*size, size);
+			dbs[node].giveVIPSelection(vipBuffer);
 			//printArray(buffer, nodes*size);
 		}
 		int thisNode = rand() % nodes;
 		dbs[thisNode].setIncomingBuffer(buffer, size, nodes, thisNode);
+		dbs[thisNode].setIncomingVIPBuffer(vipBuffer.data(), vipBuffer.size());
 		int vipsFound = 0;
 		vector<int> c;
 		while (dbs[thisNode].getNextIncomingVIPClause(c)) {
@@ -190,6 +218,166 @@ void memoutTest() {
 	}
 }
 
+// Import throughput: one thread adds batches of clauses, another one consumes them
+#define IMPORT_BENCH_BATCH 1000
+struct ImportBenchData {
+	ImportBuffer buffer;
+	// the original Lingeling import queue
+	Mutex lock;
+	vector<vector<int> > queue;
+	int* clsBuffer;
+	size_t clsBufferSize;
+	int rounds;
+	unsigned long consumed;
+};
+
+void* importBenchProducer(void* arg) {
+	ImportBenchData* d = (ImportBenchData*)arg;
+	vector<vector<int> > batch;
+	for (int i = 0; i < IMPORT_BENCH_BATCH; i++) {
+		vector<int> cls = makeRandomCls(2 + (rand() % 10), 10000);
+		cls.insert(cls.begin(), 1 + (rand() % 8));
+		batch.push_back(cls);
+	}
+	for (int r = 0; r < d->rounds; r++) {
+		if (d->clsBuffer == NULL) {
+			d->buffer.add(batch);
+		} else {
+			d->lock.lock();
+			d->queue.insert(d->queue.end(), batch.begin(), batch.end());
+			d->lock.unlock();
+		}
+	}
+	return NULL;
+}
+
+void* importBenchConsumer(void* arg) {
+	ImportBenchData* d = (ImportBenchData*)arg;
+	unsigned long total = (unsigned long)d->rounds * IMPORT_BENCH_BATCH;
+	long checksum = 0;
+	int glue;
+	while (d->consumed < total) {
+		int* cls = NULL;
+		if (d->clsBuffer == NULL) {
+			cls = d->buffer.next(&glue);
+		} else if (!d->queue.empty() && d->lock.tryLock()) {
+			vector<int> c = d->queue.back();
+			d->queue.pop_back();
+			if (c.size()+1 >= d->clsBufferSize) {
+				d->clsBufferSize = 2*c.size();
+				d->clsBuffer = (int*)realloc((void*)d->clsBuffer, d->clsBufferSize * sizeof(int));
+			}
+			glue = c[0]-1;
+			for (size_t i = 1; i < c.size(); i++) {
+				d->clsBuffer[i-1] = c[i];
+			}
+			d->clsBuffer[c.size()-1] = 0;
+			cls = d->clsBuffer;
+			d->lock.unlock();
+		}
+		if (cls != NULL) {
+			checksum += cls[0] + glue;
+			d->consumed++;
+		}
+	}
+	return (void*)checksum;
+}
+
+void importBenchmark(int rounds) {
+	for (int legacy = 0; legacy < 2; legacy++) {
+		ImportBenchData d;
+		d.rounds = rounds;
+		d.consumed = 0;
+		d.clsBufferSize = 100;
+		d.clsBuffer = legacy ? (int*)malloc(d.clsBufferSize*sizeof(int)) : NULL;
+		double start = getTime();
+		Thread consumer(importBenchConsumer, &d);
+		Thread producer(importBenchProducer, &d);
+		producer.join();
+		consumer.join();
+		double time = getTime() - start;
+		printf("%s import: %lu clauses in %.3f seconds, %.0f clauses/sec\n",
+				legacy ? "vector queue" : "import buffer", d.consumed, time, d.consumed/time);
+		free(d.clsBuffer);
+	}
+}
+
+// Allocations per shared clause on one node: the export callback, the clause
+// database, the selection of the incoming clauses and the import queue of a solver.
+// The first rounds fill the pools and are not measured.
+#define ALLOC_BENCH_CLAUSES 300
+#define ALLOC_BENCH_WARMUP 10
+void allocationBenchmark(int rounds) {
+	vector<vector<int> > learned;
+	for (int i = 0; i < ALLOC_BENCH_CLAUSES; i++) {
+		vector<int> cls = makeRandomCls(2 + (rand() % 6), 10000);
+		cls.insert(cls.begin(), 1 + (rand() % 8));
+		learned.push_back(cls);
+	}
+	for (int legacy = 0; legacy < 2; legacy++) {
+		ClauseDatabase cdb;
+		int outBuffer[1500];
+		vector<int> exportBuffer;
+		vector<vector<int> > clausesToAdd;
+		ClausePool pool;
+		ImportBuffer importBuffer;
+		vector<vector<int> > importQueue;
+		unsigned long shared = 0;
+		unsigned long startAllocations = 0;
+		long checksum = 0;
+		for (int r = 0; r < rounds; r++) {
+			if (r == ALLOC_BENCH_WARMUP) {
+				startAllocations = allocations;
+				shared = 0;
+			}
+			// the solver thread exports its learned clauses
+			for (size_t i = 0; i < learned.size(); i++) {
+				if (legacy) {
+					vector<int> vcls(learned[i].begin(), learned[i].end());
+					cdb.addClause(vcls);
+				} else {
+					exportBuffer.assign(learned[i].begin(), learned[i].end());
+					cdb.addClause(exportBuffer);
+				}
+			}
+			// the main thread selects the clauses and imports the received ones
+			cdb.giveSelection(outBuffer, 1500, NULL);
+			cdb.setIncomingBuffer(outBuffer, 1500, 1, -1);
+			vector<int> cl;
+			while (cdb.getNextIncomingClause(cl)) {
+				if (legacy) {
+					clausesToAdd.push_back(cl);
+				} else {
+					pool.append(clausesToAdd, cl);
+				}
+				shared++;
+			}
+			if (legacy) {
+				importQueue.insert(importQueue.end(), clausesToAdd.begin(), clausesToAdd.end());
+				clausesToAdd.clear();
+			} else {
+				importBuffer.add(clausesToAdd);
+				pool.recycle(clausesToAdd);
+			}
+			// the solver thread imports them
+			if (legacy) {
+				for (size_t i = 0; i < importQueue.size(); i++) {
+					checksum += importQueue[i][1];
+				}
+				importQueue.clear();
+			} else {
+				int glue;
+				int* cls;
+				while ((cls = importBuffer.next(&glue)) != NULL) {
+					checksum += cls[0];
+				}
+			}
+		}
+		printf("%s: %lu clauses shared, %.3f allocations per shared clause (checksum %ld)\n",
+				legacy ? "vectors" : "pools", shared, (allocations - startAllocations)/(double)shared, checksum);
+	}
+}
+
 int main(int argc, char **argv) {
 	unsigned int s = 4;
 	int x = (-1/s)*s;
@@ -197,6 +385,8 @@ int main(int argc, char **argv) {
 	//testClauseDatabaseRandom(10000);
 	//testClauseDatabaseManual();
 	//memoutTest();
+	//importBenchmark(2000);
+	//allocationBenchmark(1000);
 	dataTest();
 }
 
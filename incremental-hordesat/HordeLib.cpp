@@ -47,7 +47,7 @@
 #include <csignal>
 #include <unistd.h>
 #include "utilities/Logger.h"
-#include <sched.h>
+#include "utilities/Topology.h"
 
 
 // =========================
@@ -123,25 +123,29 @@ bool getGlobalEndingAsynchronous(int mpi_size, int mpi_rank, bool solvingDoneLoc
 	return false;
 }
 
-void pinThread(int solversCount) {
-	static int lastCpu = 0;
-	int numCores = sysconf(_SC_NPROCESSORS_ONLN);
+// Spread the solvers of all the ranks on this machine over its NUMA nodes.
+// If the launcher already bound the rank to some cores only those are used.
+void HordeLib::placeThreads() {
+	Topology topology;
+	MPI_Comm localComm;
 	int localRank = 0;
-	const char* lranks = getenv("OMPI_COMM_WORLD_LOCAL_RANK");
-	if (lranks == NULL) {
-		log(0, "WARNING: local rank was not determined.\n");
-	} else {
-		localRank = atoi(lranks);
+	MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &localComm);
+	if (!topology.isRestricted()) {
+		MPI_Comm_rank(localComm, &localRank);
 	}
-	int desiredCpu = lastCpu + localRank*solversCount;
-	lastCpu++;
-	log(0, "Pinning thread to proc %d of %d, local rank is %d\n",
-			desiredCpu, numCores, localRank);
-
-	cpu_set_t cpuSet;
-	CPU_ZERO(&cpuSet);
-	CPU_SET(desiredCpu, &cpuSet);
-	sched_setaffinity(0, sizeof(cpuSet), &cpuSet);
+	MPI_Comm_free(&localComm);
+	if (localRank*solversCount + solversCount > topology.getCpusCount()) {
+		log(0, "WARNING: more solvers than cpus, some solvers share a cpu\n");
+	}
+	for (int i = 0; i < solversCount; i++) {
+		int cpu = topology.getSolverCpu(localRank*solversCount + i);
+		solverCpus.push_back(cpu);
+		log(1, "Pinning solver %d of node %d to cpu %d (numa node %d of %d)\n", i, mpi_rank, cpu,
+				topology.getNode(cpu), topology.getNodesCount());
+	}
+	// the calling thread does the communication, it stays on the node of solver 0
+	mainThreadCpus = topology.getNodeCpus(topology.getNode(solverCpus[0]));
+	pinCurrentThread(mainThreadCpus);
 }
 
 struct threadArgs {
@@ -153,12 +157,10 @@ void* solverRunningThread(void* arg) {
 	threadArgs* targs = (threadArgs*)arg;
 	HordeLib* hlib = targs->hlib;
 	PortfolioSolverInterface* solver = hlib->solvers[targs->solverId];
-	delete targs;
-	if (hlib->params.isSet("pin")) {
-		hlib->interruptLock.lock();
-		pinThread(hlib->params.getIntParam("c", 1));
-		hlib->interruptLock.unlock();
+	if (!hlib->solverCpus.empty()) {
+		pinCurrentThread(hlib->solverCpus[targs->solverId]);
 	}
+	delete targs;
 	while (true) {
 		hlib->interruptLock.lock();
 		if (hlib->solvingDoneLocal) {
@@ -247,7 +249,40 @@ void HordeLib::binValueDiversification(int mpi_size, int mpi_rank) {
     }
 }
 
+// The variables of the clauses and assumptions given so far are frozen,
+// the later ones have to be frozen by the user (see freeze).
+void HordeLib::preprocessFormula() {
+	preprocessed = true;
+	for (size_t i = 0; i < assumptions.size(); i++) {
+		preprocessor.freeze(abs(assumptions[i]));
+	}
+	if (!preprocessor.preprocess(formula, solversCount)) {
+		// the empty clause makes the solvers report unsatisfiability
+		formula.assign(1, vector<int>());
+	}
+	for (int i = 0; i < solversCount; i++) {
+		if (!solverCpus.empty()) {
+			pinCurrentThread(solverCpus[i]);
+		}
+		solvers[i]->addInitialClauses(formula);
+	}
+	if (!solverCpus.empty()) {
+		pinCurrentThread(mainThreadCpus);
+	}
+	vector<vector<int> >().swap(formula);
+}
+
+void HordeLib::checkNotRemoved(int lit) {
+	if (preprocessed && preprocessor.isRemoved(abs(lit))) {
+		exitError("Variable %d was removed by the preprocessing, it has to be frozen before the first solve call\n",
+				abs(lit));
+	}
+}
+
 int HordeLib::solve() {
+	if (usePreprocessing && !preprocessed) {
+		preprocessFormula();
+	}
 	solvingDoneLocal = false;
 	for (int i = 0; i < solversCount; i++) {
 		threadArgs* arg = new threadArgs();
@@ -290,6 +325,9 @@ int HordeLib::solve() {
 		solverThreads[i]->join();
 	}
 	MPI_Barrier(MPI_COMM_WORLD);
+	if (usePreprocessing && finalResult == SAT) {
+		preprocessor.extendModel(truthValues);
+	}
 
 	if (params.isSet("stats")) {
 		// Statistics gathering
@@ -345,16 +383,32 @@ int HordeLib::solve() {
 bool HordeLib::readFormula(const char* filename) {
 	if (params.isSet("qbf")) {
 		for (size_t i = 0; i < solvers.size(); i++) {
+			if (!solverCpus.empty()) {
+				pinCurrentThread(solverCpus[i]);
+			}
 			solvers[i]->loadFormula(filename);
 		}
+	} else if (usePreprocessing) {
+		// given to the solvers by the first solve call
+		::readFormula(filename, formula);
 	} else {
-		loadFormulaToSolvers(solvers, filename);
+		loadFormulaToSolvers(solvers, filename, solverCpus);
+	}
+	if (!solverCpus.empty()) {
+		pinCurrentThread(mainThreadCpus);
 	}
 	return true;
 }
 
 // incremental iface
 void HordeLib::addLit(int lit) {
+	if (usePreprocessing) {
+		// the clauses added before the first solve call bypass the preprocessing
+		if (!preprocessed && lit != 0) {
+			preprocessor.freeze(abs(lit));
+		}
+		checkNotRemoved(lit);
+	}
 	litsAdded++;
 	for (int i = 0; i < solversCount; i++) {
 		solvers[i]->addLiteral(lit);
@@ -362,6 +416,9 @@ void HordeLib::addLit(int lit) {
 }
 
 void HordeLib::assume(int lit) {
+	if (usePreprocessing) {
+		checkNotRemoved(lit);
+	}
 	assumptions.push_back(lit);
 }
 
@@ -373,12 +430,21 @@ int HordeLib::failed(int lit) {
 	return failedAssumptions.find(lit) != failedAssumptions.end();
 }
 
+void HordeLib::freeze(int var) {
+	if (usePreprocessing) {
+		checkNotRemoved(var);
+	}
+	preprocessor.freeze(var);
+}
+
 
 HordeLib::HordeLib(int argc, char** argv) {
 	solverThreads = NULL;
 	endingFunction = NULL;
 	sharingManager = NULL;
 	params.init(argc, argv);
+	usePreprocessing = params.isSet("pre") && !params.isSet("qbf");
+	preprocessed = false;
 
 	MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
 	MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
@@ -394,8 +460,15 @@ HordeLib::HordeLib(int argc, char** argv) {
 
 	solversCount = params.getIntParam("c", 1);
 	//printf("solvers is %d", solversCount);
+	if (params.isSet("pin")) {
+		placeThreads();
+	}
 
 	for (int i = 0; i < solversCount; i++) {
+		// memory is placed on the NUMA node of the thread touching it first
+		if (!solverCpus.empty()) {
+			pinCurrentThread(solverCpus[i]);
+		}
 		if (params.isSet("qbf")) {
 			solvers.push_back(new DepQBF());
 			log(1, "Running DepQBF on core %d of node %d/%d\n", i, mpi_rank, mpi_size);
@@ -417,6 +490,9 @@ HordeLib::HordeLib(int argc, char** argv) {
 		// set solver id
 		solvers[i]->solverId = i + solversCount * mpi_rank;
 	}
+	if (!solverCpus.empty()) {
+		pinCurrentThread(mainThreadCpus);
+	}
 
 	sleepInt = 1000 * params.getIntParam("i", 1000);
 	endingFunction = getGlobalEnding;
@@ -10,6 +10,7 @@
 
 #include "utilities/ParameterProcessor.h"
 #include "utilities/Threading.h"
+#include "utilities/Preprocessor.h"
 #include "solvers/MiniSat.h"
 #include "solvers/Lingeling.h"
 #include "solvers/DepQBF.h"
@@ -35,14 +36,25 @@ private:
 	Mutex interruptLock;
 	SharingManagerInterface* sharingManager;
 	vector<PortfolioSolverInterface*> solvers;
+	// the CPU of each solver thread, empty if the threads are not pinned
+	vector<int> solverCpus;
+	vector<int> mainThreadCpus;
 
 	SatResult finalResult;
 	vector<int> assumptions;
 	vector<int> truthValues;
 	set<int> failedAssumptions;
 
+	// with -pre the formula read from the file is simplified before the first solve
+	bool usePreprocessing;
+	bool preprocessed;
+	Preprocessor preprocessor;
+	vector<vector<int> > formula;
+	void preprocessFormula();
+	void checkNotRemoved(int lit);
 
 	void stopAllSolvers();
+	void placeThreads();
 	// diversifications
 	void sparseDiversification(int mpi_size, int mpi_rank);
 	void randomDiversification(unsigned int seed);
@@ -73,6 +85,9 @@ public:
 	int solve();
 	int value(int lit);
 	int failed(int lit);
+	// Keep the variable for the clauses and assumptions given after the first
+	// solve call, it is not removed by the preprocessing (-pre)
+	void freeze(int var);
 	ParameterProcessor& getParams() {
 		return params;
 	}
@@ -55,7 +55,8 @@ int main(int argc, char** argv) {
 		puts("        -i=<INT>\t communication interval in miliseconds, default is 1000 (50 for -e=3).");
 		puts("        -t=<INT>\t timelimit in seconds, default is unlimited.");
 		puts("        -barrier\t Use extra barriers to measuse communication.");
-		puts("        -pin\t\t Pin solver threads to cores.");
+		puts("        -pin\t\t Pin solver threads to cores spread over the NUMA nodes.");
+		puts("        -pre\t\t preprocess the formula once per node before the first solve call.");
 		puts("        -nls\t\t No local (shared memory) clause sharing.");
 		puts("        -pp\t\t Use Push-Pull protocol (when using e=3).");
 		return 0;
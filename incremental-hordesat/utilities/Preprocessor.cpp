@@ -0,0 +1,511 @@
+/*
+ * Preprocessor.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#include "Preprocessor.h"
+#include "Threading.h"
+#include "Logger.h"
+#include <algorithm>
+
+Preprocessor::Preprocessor() {
+	numVars = 0;
+	unitsHead = 0;
+}
+
+void Preprocessor::freeze(int var) {
+	if ((int)frozen.size() <= var) {
+		frozen.resize(var+1, false);
+	}
+	frozen[var] = true;
+}
+
+// Sort the literals, remove duplicates and false literals,
+// return false if the clause is satisfied or a tautology
+bool Preprocessor::normalize(vector<int>& cls) {
+	sort(cls.begin(), cls.end());
+	cls.erase(unique(cls.begin(), cls.end()), cls.end());
+	size_t j = 0;
+	for (size_t i = 0; i < cls.size(); i++) {
+		int val = value(cls[i]);
+		if (val > 0 || (cls[i] > 0 && binary_search(cls.begin(), cls.end(), -cls[i]))) {
+			return false;
+		}
+		if (val == 0) {
+			cls[j++] = cls[i];
+		}
+	}
+	cls.resize(j);
+	return true;
+}
+
+bool Preprocessor::assign(int lit) {
+	int val = value(lit);
+	if (val != 0) {
+		return val > 0;
+	}
+	values[abs(lit)] = lit > 0 ? 1 : -1;
+	units.push_back(lit);
+	stats.fixedVars++;
+	return true;
+}
+
+// Add a clause, return false if it is empty
+bool Preprocessor::addClause(vector<int>& cls) {
+	if (!normalize(cls)) {
+		return true;
+	}
+	if (cls.empty()) {
+		return false;
+	}
+	if (cls.size() == 1) {
+		return assign(cls[0]);
+	}
+	int c = clauses.size();
+	clauses.push_back(cls);
+	deleted.push_back(false);
+	for (size_t i = 0; i < cls.size(); i++) {
+		occurrences[litIndex(cls[i])].push_back(c);
+	}
+	return true;
+}
+
+void Preprocessor::deleteClause(int c) {
+	deleted[c] = true;
+	vector<int>().swap(clauses[c]);
+}
+
+void Preprocessor::cleanOccurrences(int lit) {
+	vector<int>& occ = occurrences[litIndex(lit)];
+	size_t j = 0;
+	for (size_t i = 0; i < occ.size(); i++) {
+		int c = occ[i];
+		if (!deleted[c] && binary_search(clauses[c].begin(), clauses[c].end(), lit)) {
+			occ[j++] = c;
+		}
+	}
+	occ.resize(j);
+}
+
+bool Preprocessor::propagate() {
+	while (unitsHead < units.size()) {
+		int lit = units[unitsHead++];
+		vector<int>& satisfied = occurrences[litIndex(lit)];
+		for (size_t i = 0; i < satisfied.size(); i++) {
+			if (!deleted[satisfied[i]]) {
+				deleteClause(satisfied[i]);
+			}
+		}
+		vector<int>().swap(satisfied);
+		vector<int>& falsified = occurrences[litIndex(-lit)];
+		for (size_t i = 0; i < falsified.size(); i++) {
+			int c = falsified[i];
+			if (deleted[c]) {
+				continue;
+			}
+			vector<int>& cls = clauses[c];
+			vector<int>::iterator it = lower_bound(cls.begin(), cls.end(), -lit);
+			if (it == cls.end() || *it != -lit) {
+				continue;
+			}
+			cls.erase(it);
+			if (cls.empty()) {
+				return false;
+			}
+			if (cls.size() == 1) {
+				int unit = cls[0];
+				deleteClause(c);
+				if (!assign(unit)) {
+					return false;
+				}
+			}
+		}
+		vector<int>().swap(falsified);
+	}
+	return true;
+}
+
+// Find the strongly connected components of the binary implication graph
+// (iterative Tarjan) and replace each literal by the representative of its
+// component.
+bool Preprocessor::substituteEquivalences() {
+	int nodes = 2*numVars+2;
+	vector<vector<int> > edges(nodes);
+	for (size_t c = 0; c < clauses.size(); c++) {
+		if (!deleted[c] && clauses[c].size() == 2) {
+			int a = clauses[c][0];
+			int b = clauses[c][1];
+			edges[litIndex(-a)].push_back(litIndex(b));
+			edges[litIndex(-b)].push_back(litIndex(a));
+		}
+	}
+	vector<int> index(nodes, -1);
+	vector<int> lowlink(nodes, 0);
+	vector<int> component(nodes, -1);
+	vector<bool> onStack(nodes, false);
+	vector<int> stack;
+	vector<pair<int, size_t> > callStack;
+	int counter = 0;
+	int components = 0;
+	for (int start = 2; start < nodes; start++) {
+		if (index[start] >= 0) {
+			continue;
+		}
+		callStack.push_back(make_pair(start, 0));
+		index[start] = lowlink[start] = counter++;
+		stack.push_back(start);
+		onStack[start] = true;
+		while (!callStack.empty()) {
+			int node = callStack.back().first;
+			size_t& edge = callStack.back().second;
+			if (edge < edges[node].size()) {
+				int next = edges[node][edge++];
+				if (index[next] < 0) {
+					index[next] = lowlink[next] = counter++;
+					stack.push_back(next);
+					onStack[next] = true;
+					callStack.push_back(make_pair(next, 0));
+				} else if (onStack[next]) {
+					lowlink[node] = min(lowlink[node], index[next]);
+				}
+				continue;
+			}
+			if (lowlink[node] == index[node]) {
+				int member;
+				do {
+					member = stack.back();
+					stack.pop_back();
+					onStack[member] = false;
+					component[member] = components;
+				} while (member != node);
+				components++;
+			}
+			callStack.pop_back();
+			if (!callStack.empty()) {
+				int parent = callStack.back().first;
+				lowlink[parent] = min(lowlink[parent], lowlink[node]);
+			}
+		}
+	}
+
+	// the representative of a component is a frozen literal if there is one,
+	// otherwise the literal with the smallest variable
+	vector<int> representative(components, 0);
+	for (int var = 1; var <= numVars; var++) {
+		int comp = component[litIndex(var)];
+		if (comp == component[litIndex(-var)]) {
+			return false;
+		}
+		int& rep = representative[comp];
+		if (rep == 0 || (isFrozen(var) && !isFrozen(abs(rep)))) {
+			rep = var;
+		}
+		int& negRep = representative[component[litIndex(-var)]];
+		if (negRep == 0 || (isFrozen(var) && !isFrozen(abs(negRep)))) {
+			negRep = -var;
+		}
+	}
+	vector<int> substitute(numVars+1, 0);
+	int substituted = 0;
+	for (int var = 1; var <= numVars; var++) {
+		int rep = representative[component[litIndex(var)]];
+		if (rep == var || isFrozen(var) || value(var) != 0) {
+			substitute[var] = var;
+			continue;
+		}
+		substitute[var] = rep;
+		removed[var] = true;
+		substituted++;
+		vector<int> cls(2);
+		cls[0] = var; cls[1] = -rep;
+		extension.push_back(cls);
+		cls[0] = -var; cls[1] = rep;
+		extension.push_back(cls);
+	}
+	if (substituted == 0) {
+		return true;
+	}
+	stats.substitutedVars += substituted;
+
+	vector<vector<int> > old;
+	for (size_t c = 0; c < clauses.size(); c++) {
+		if (!deleted[c]) {
+			old.push_back(clauses[c]);
+		}
+	}
+	clauses.clear();
+	deleted.clear();
+	occurrences.assign(nodes, vector<int>());
+	for (size_t c = 0; c < old.size(); c++) {
+		for (size_t i = 0; i < old[c].size(); i++) {
+			int lit = old[c][i];
+			old[c][i] = lit > 0 ? substitute[lit] : -substitute[-lit];
+		}
+		if (!addClause(old[c])) {
+			return false;
+		}
+	}
+	return propagate();
+}
+
+void Preprocessor::findSubsumed(size_t from, size_t to, vector<int>& subsumed) {
+	for (size_t c = from; c < to; c++) {
+		if (deleted[c]) {
+			continue;
+		}
+		const vector<int>& cls = clauses[c];
+		int minLit = cls[0];
+		for (size_t i = 1; i < cls.size(); i++) {
+			if (occurrences[litIndex(cls[i])].size() < occurrences[litIndex(minLit)].size()) {
+				minLit = cls[i];
+			}
+		}
+		const vector<int>& occ = occurrences[litIndex(minLit)];
+		if (occ.size() > PRE_SUBSUME_OCC_LIMIT) {
+			continue;
+		}
+		for (size_t i = 0; i < occ.size(); i++) {
+			size_t d = occ[i];
+			const vector<int>& other = clauses[d];
+			// from two equal clauses only the later one is removed
+			if (d == c || deleted[d] || other.size() < cls.size() || (other.size() == cls.size() && d < c)) {
+				continue;
+			}
+			if (includes(other.begin(), other.end(), cls.begin(), cls.end())) {
+				subsumed.push_back(d);
+			}
+		}
+	}
+}
+
+struct SubsumeJob {
+	Preprocessor* pre;
+	size_t from;
+	size_t to;
+	vector<int> subsumed;
+};
+
+void* subsumeThread(void* arg) {
+	SubsumeJob* job = (SubsumeJob*)arg;
+	job->pre->findSubsumed(job->from, job->to, job->subsumed);
+	return NULL;
+}
+
+// Remove the subsumed clauses (searched for in parallel) and strengthen
+// clauses by self-subsuming resolution.
+bool Preprocessor::subsume(int threads) {
+	for (int lit = -numVars; lit <= numVars; lit++) {
+		if (lit != 0) {
+			cleanOccurrences(lit);
+		}
+	}
+	vector<SubsumeJob> jobs(threads);
+	vector<Thread*> workers;
+	size_t chunk = clauses.size() / threads + 1;
+	for (int t = 0; t < threads; t++) {
+		jobs[t].pre = this;
+		jobs[t].from = min(clauses.size(), t * chunk);
+		jobs[t].to = min(clauses.size(), (t+1) * chunk);
+		workers.push_back(new Thread(subsumeThread, &jobs[t]));
+	}
+	for (int t = 0; t < threads; t++) {
+		workers[t]->join();
+		delete workers[t];
+		for (size_t i = 0; i < jobs[t].subsumed.size(); i++) {
+			int d = jobs[t].subsumed[i];
+			if (!deleted[d]) {
+				deleteClause(d);
+				stats.subsumedClauses++;
+			}
+		}
+	}
+
+	for (size_t c = 0; c < clauses.size(); c++) {
+		if (deleted[c]) {
+			continue;
+		}
+		for (size_t i = 0; i < clauses[c].size() && !deleted[c]; i++) {
+			int lit = clauses[c][i];
+			vector<int>& occ = occurrences[litIndex(-lit)];
+			if (occ.size() > PRE_SUBSUME_OCC_LIMIT) {
+				continue;
+			}
+			for (size_t j = 0; j < occ.size(); j++) {
+				size_t d = occ[j];
+				vector<int>& other = clauses[d];
+				if (d == c || deleted[d] || other.size() < clauses[c].size()) {
+					continue;
+				}
+				vector<int>::iterator pos = lower_bound(other.begin(), other.end(), -lit);
+				if (pos == other.end() || *pos != -lit) {
+					continue;
+				}
+				// (lit C) and (-lit C D) resolve to (C D) which replaces the second
+				bool strengthens = true;
+				for (size_t k = 0; k < clauses[c].size() && strengthens; k++) {
+					int x = clauses[c][k];
+					strengthens = x == lit || binary_search(other.begin(), other.end(), x);
+				}
+				if (!strengthens) {
+					continue;
+				}
+				other.erase(pos);
+				stats.strengthenedClauses++;
+				if (other.size() == 1) {
+					int unit = other[0];
+					deleteClause(d);
+					if (!assign(unit)) {
+						return false;
+					}
+				}
+			}
+		}
+	}
+	return propagate();
+}
+
+// Bounded variable elimination, a variable is eliminated if the
+// resolvents are not more than the clauses they replace.
+bool Preprocessor::eliminate() {
+	vector<pair<long, int> > candidates;
+	for (int var = 1; var <= numVars; var++) {
+		if (isFrozen(var) || values[var] != 0) {
+			continue;
+		}
+		cleanOccurrences(var);
+		cleanOccurrences(-var);
+		long pos = occurrences[litIndex(var)].size();
+		long neg = occurrences[litIndex(-var)].size();
+		if (pos + neg > 0) {
+			candidates.push_back(make_pair(pos * neg, var));
+		}
+	}
+	sort(candidates.begin(), candidates.end());
+
+	vector<vector<int> > resolvents;
+	for (size_t ci = 0; ci < candidates.size(); ci++) {
+		int var = candidates[ci].second;
+		if (values[var] != 0) {
+			continue;
+		}
+		cleanOccurrences(var);
+		cleanOccurrences(-var);
+		vector<int> pos = occurrences[litIndex(var)];
+		vector<int> neg = occurrences[litIndex(-var)];
+		bool pure = pos.empty() || neg.empty();
+		if (!pure && pos.size() + neg.size() > PRE_ELIM_OCC_LIMIT) {
+			continue;
+		}
+		resolvents.clear();
+		bool possible = true;
+		for (size_t p = 0; p < pos.size() && possible; p++) {
+			for (size_t n = 0; n < neg.size() && possible; n++) {
+				vector<int> res;
+				for (size_t i = 0; i < clauses[pos[p]].size(); i++) {
+					if (clauses[pos[p]][i] != var) {
+						res.push_back(clauses[pos[p]][i]);
+					}
+				}
+				for (size_t i = 0; i < clauses[neg[n]].size(); i++) {
+					if (clauses[neg[n]][i] != -var) {
+						res.push_back(clauses[neg[n]][i]);
+					}
+				}
+				if (!normalize(res)) {
+					continue;
+				}
+				resolvents.push_back(res);
+				possible = res.size() <= PRE_ELIM_CLAUSE_LIMIT && resolvents.size() <= pos.size() + neg.size();
+			}
+		}
+		if (!possible) {
+			continue;
+		}
+		for (int side = 0; side < 2; side++) {
+			vector<int>& occ = side == 0 ? pos : neg;
+			int lit = side == 0 ? var : -var;
+			for (size_t i = 0; i < occ.size(); i++) {
+				vector<int> cls(1, lit);
+				for (size_t j = 0; j < clauses[occ[i]].size(); j++) {
+					if (clauses[occ[i]][j] != lit) {
+						cls.push_back(clauses[occ[i]][j]);
+					}
+				}
+				extension.push_back(cls);
+				deleteClause(occ[i]);
+			}
+		}
+		removed[var] = true;
+		stats.eliminatedVars++;
+		for (size_t i = 0; i < resolvents.size(); i++) {
+			if (!addClause(resolvents[i])) {
+				return false;
+			}
+		}
+		if (!propagate()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool Preprocessor::preprocess(vector<vector<int> >& formula, int threads) {
+	double start = getTime();
+	for (size_t i = 0; i < formula.size(); i++) {
+		for (size_t j = 0; j < formula[i].size(); j++) {
+			numVars = max(numVars, abs(formula[i][j]));
+		}
+	}
+	values.assign(numVars+1, 0);
+	removed.assign(numVars+1, false);
+	occurrences.assign(2*numVars+2, vector<int>());
+	size_t originalSize = formula.size();
+	bool sat = true;
+	for (size_t i = 0; i < formula.size() && sat; i++) {
+		sat = addClause(formula[i]);
+	}
+	vector<vector<int> >().swap(formula);
+	sat = sat && propagate() && substituteEquivalences() && subsume(max(1, threads)) && eliminate();
+	if (!sat) {
+		log(1, "preprocessing found the formula unsatisfiable\n");
+		return false;
+	}
+
+	for (int var = 1; var <= numVars; var++) {
+		if (values[var] != 0) {
+			formula.push_back(vector<int>(1, values[var] * var));
+		}
+	}
+	for (size_t c = 0; c < clauses.size(); c++) {
+		if (!deleted[c]) {
+			formula.push_back(clauses[c]);
+		}
+	}
+	vector<vector<int> >().swap(clauses);
+	vector<vector<int> >().swap(occurrences);
+	log(1, "preprocessing took %.2f seconds, clauses %lu -> %lu, fixed:%lu substituted:%lu eliminated:%lu "
+			"subsumed:%lu strengthened:%lu\n", getTime() - start, originalSize, formula.size(), stats.fixedVars,
+			stats.substitutedVars, stats.eliminatedVars, stats.subsumedClauses, stats.strengthenedClauses);
+	return true;
+}
+
+void Preprocessor::extendModel(vector<int>& model) {
+	int size = model.size();
+	// the model may also have the variables added after the preprocessing
+	model.resize(max(size, numVars+1));
+	for (int var = max(1, size); var <= numVars; var++) {
+		model[var] = -var;
+	}
+	for (int i = extension.size()-1; i >= 0; i--) {
+		const vector<int>& cls = extension[i];
+		bool satisfied = false;
+		for (size_t j = 0; j < cls.size() && !satisfied; j++) {
+			satisfied = model[abs(cls[j])] == cls[j];
+		}
+		if (!satisfied) {
+			model[abs(cls[0])] = cls[0];
+		}
+	}
+}
@@ -0,0 +1,106 @@
+/*
+ * Preprocessor.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: balyo
+ */
+
+#ifndef PREPROCESSOR_H_
+#define PREPROCESSOR_H_
+
+#include <stdlib.h>
+#include <vector>
+using namespace std;
+
+// variables with more occurrences than this are not eliminated
+#define PRE_ELIM_OCC_LIMIT 16
+// resolvents longer than this prevent the elimination
+#define PRE_ELIM_CLAUSE_LIMIT 24
+// occurrence lists longer than this are not searched for subsumed clauses
+#define PRE_SUBSUME_OCC_LIMIT 1000
+
+struct PreprocessingStatistics {
+	PreprocessingStatistics():fixedVars(0),substitutedVars(0),eliminatedVars(0),
+			subsumedClauses(0),strengthenedClauses(0) {}
+	unsigned long fixedVars;
+	unsigned long substitutedVars;
+	unsigned long eliminatedVars;
+	unsigned long subsumedClauses;
+	unsigned long strengthenedClauses;
+};
+
+/**
+ * Simplifies the formula once for all the solvers of the node using unit
+ * propagation, equivalent literal substitution, subsumption, self-subsuming
+ * resolution and bounded variable elimination. The removed clauses are kept
+ * on an extension stack to turn a model of the simplified formula into
+ * a model of the original one. Frozen variables are never substituted
+ * or eliminated, so they can be used in assumptions and later clauses.
+ * The other variables of the input formula are only safe to use again if
+ * they were not removed (see isRemoved).
+ */
+class Preprocessor {
+public:
+	Preprocessor();
+
+	void freeze(int var);
+	/**
+	 * Simplify the clauses in place using the given number of threads,
+	 * return false if the formula was found unsatisfiable.
+	 */
+	bool preprocess(vector<vector<int> >& formula, int threads);
+	/**
+	 * Extend a model (model[var] is var or -var) of the simplified formula
+	 * to a model of the original formula.
+	 */
+	void extendModel(vector<int>& model);
+	/**
+	 * Return true if the variable was substituted or eliminated, it
+	 * must not occur in the clauses or assumptions given later.
+	 */
+	bool isRemoved(int var) {
+		return var < (int)removed.size() && removed[var];
+	}
+
+	PreprocessingStatistics getStatistics() {
+		return stats;
+	}
+
+private:
+	int numVars;
+	vector<bool> frozen;
+	vector<bool> removed;
+	vector<vector<int> > clauses;
+	vector<bool> deleted;
+	// indexed by litIndex, the lists are cleaned lazily
+	vector<vector<int> > occurrences;
+	vector<signed char> values;
+	vector<int> units;
+	size_t unitsHead;
+	// removed clauses, the first literal is the one to flip if it is falsified
+	vector<vector<int> > extension;
+	PreprocessingStatistics stats;
+
+	int litIndex(int lit) {
+		return 2*abs(lit) + (lit < 0);
+	}
+	int value(int lit) {
+		return lit > 0 ? values[lit] : -values[-lit];
+	}
+	bool isFrozen(int var) {
+		return var < (int)frozen.size() && frozen[var];
+	}
+	bool normalize(vector<int>& cls);
+	bool assign(int lit);
+	bool addClause(vector<int>& cls);
+	void deleteClause(int c);
+	void cleanOccurrences(int lit);
+	bool propagate();
+	bool substituteEquivalences();
+	bool subsume(int threads);
+	bool eliminate();
+	friend void* subsumeThread(void* arg);
+	void findSubsumed(size_t from, size_t to, vector<int>& subsumed);
+};
+
+#endif /* PREPROCESSOR_H_ */
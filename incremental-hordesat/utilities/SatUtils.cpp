@@ -6,17 +6,17 @@
  */
 
 #include "SatUtils.h"
+#include "Topology.h"
 #include <ctype.h>
 #include <stdio.h>
 
-bool loadFormulaToSolvers(vector<PortfolioSolverInterface*> solvers, const char* filename) {
+bool readFormula(const char* filename, vector<vector<int> >& clauses) {
 	FILE* f = fopen(filename, "r");
 	if (f == NULL) {
 		return false;
 	}
 	int c = 0;
 	bool neg = false;
-	vector<vector<int> > clauses;
 	vector<int> cls;
 	while (c != EOF) {
 		c = fgetc(f);
@@ -61,8 +61,19 @@ bool loadFormulaToSolvers(vector<PortfolioSolverInterface*> solvers, const char*
 		}
 	}
 	fclose(f);
+	return true;
+}
 
+bool loadFormulaToSolvers(vector<PortfolioSolverInterface*> solvers, const char* filename,
+		const vector<int>& solverCpus) {
+	vector<vector<int> > clauses;
+	if (!readFormula(filename, clauses)) {
+		return false;
+	}
 	for (size_t i = 0; i < solvers.size(); i++) {
+		if (i < solverCpus.size()) {
+			pinCurrentThread(solverCpus[i]);
+		}
 		solvers[i]->addInitialClauses(clauses);
 	}
 
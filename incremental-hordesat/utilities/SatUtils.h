@@ -10,6 +10,16 @@
 
 #include "../solvers/PortfolioSolverInterface.h"
 
-bool loadFormulaToSolvers(vector<PortfolioSolverInterface*> solvers, const char* filename);
+/**
+ * Read the formula once and give it to each solver. If the solver cpus are
+ * given the calling thread moves to the cpu of each solver before giving it
+ * the clauses, so the solver's copy is allocated on the solver's NUMA node.
+ */
+bool loadFormulaToSolvers(vector<PortfolioSolverInterface*> solvers, const char* filename,
+		const vector<int>& solverCpus = vector<int>());
+/**
+ * Read the clauses of the formula, return false if the file cannot be opened.
+ */
+bool readFormula(const char* filename, vector<vector<int> >& clauses);
 
 #endif /* SATUTILS_H_ */
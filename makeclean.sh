@@ -2,3 +2,5 @@ rm hordesat
 rm -rf lingeling
 rm -rf minisat
 rm -rf candy/build
+rm -rf cadical
+rm -rf kissat
@@ -41,6 +41,32 @@ cmake -DCMAKE_EXPORT_COMPILE_COMMANDS=1 -DCMAKE_BUILD_TYPE=Release ..
 make candy
 cd ../..
 
+# get cadical (the adapter needs the clause import API of version 2.1)
+if [ ! -d cadical ]; then
+  wget -O cadical.zip https://github.com/arminbiere/cadical/archive/refs/tags/rel-2.1.0.zip
+  unzip cadical.zip
+  mv cadical-rel-2.1.0 cadical
+fi
+
+# make cadical
+cd cadical
+./configure
+make
+cd ..
+
+# get kissat
+if [ ! -d kissat ]; then
+  wget -O kissat.zip https://github.com/arminbiere/kissat/archive/refs/tags/rel-4.0.1.zip
+  unzip kissat.zip
+  mv kissat-rel-4.0.1 kissat
+fi
+
+# make kissat
+cd kissat
+./configure
+make
+cd ..
+
 
 # make hordesat
 cd hordesat-src
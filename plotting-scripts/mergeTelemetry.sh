@@ -0,0 +1,44 @@
+#!/bin/bash
+
+echo "USAGE: [summary=yes] ./mergeTelemetry.sh prefix.0.jsonl prefix.1.jsonl ... > timeline" >&2
+
+# The telemetry files of the ranks (hordesat -telemetry=prefix) start each
+# line with the time, sorting them gives one timeline of all the ranks.
+if [[ -z $summary ]]
+then
+    sort -t : -k 2 -g "$@"
+    exit 0
+fi
+
+# One line per round: the clause counts summed over the ranks, the slowest
+# exchange and ending detection and the average send buffer fill.
+echo "# round ranks produced selected sent received filtered imported max-exchange max-ending avg-fill"
+sort -t : -k 2 -g "$@" | awk '
+function field(name,    start, rest) {
+    start = index($0, "\"" name "\":")
+    rest = substr($0, start + length(name) + 3)
+    return rest + 0
+}
+{
+    r = field("round")
+    if (!(r in ranks)) {
+        order[++rounds] = r
+    }
+    ranks[r]++
+    produced[r] += field("produced")
+    selected[r] += field("selected")
+    sent[r] += field("sent")
+    received[r] += field("received")
+    filtered[r] += field("filtered")
+    imported[r] += field("imported")
+    fill[r] += field("fill")
+    if (field("exchange") > exchange[r]) exchange[r] = field("exchange")
+    if (field("ending") > ending[r]) ending[r] = field("ending")
+}
+END {
+    for (i = 1; i <= rounds; i++) {
+        r = order[i]
+        printf "%d %d %d %d %d %d %d %d %.6f %.6f %.1f\n", r, ranks[r], produced[r], selected[r], sent[r],
+            received[r], filtered[r], imported[r], exchange[r], ending[r], fill[r] / ranks[r]
+    }
+}'